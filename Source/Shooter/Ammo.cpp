@@ -3,12 +3,14 @@
 
 #include "Ammo.h"
 
+#include "PickupManagerSubsystem.h"
 #include "Components/BoxComponent.h"
 #include "Components/SphereComponent.h"
 #include "Components/WidgetComponent.h"
 #include "ShooterCharacter.h"
 
-AAmmo::AAmmo()
+AAmmo::AAmmo():
+	bCanBeDormant(true)
 {
 	/* Construct the ammo mesh component and set it as the root component*/
 	AmmoMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("AmmoMesh"));
@@ -24,74 +26,27 @@ AAmmo::AAmmo()
 	AmmoCollisionSphere->SetSphereRadius(50.f);
 }
 
-void AAmmo::Tick(float DeltaSeconds)
-{
-	Super::Tick(DeltaSeconds);
-}
-
 void AAmmo::BeginPlay()
 {
 	Super::BeginPlay();
 
 	AmmoCollisionSphere->OnComponentBeginOverlap.AddDynamic(this, &AAmmo::AmmoSphereOverlap);
+
+	if (bCanBeDormant && GetItemState() == EItemState::EIS_PickUp)
+	{
+		if (UPickupManagerSubsystem* PickupManager = GetWorld()->GetSubsystem<UPickupManagerSubsystem>())
+		{
+			PickupManager->RegisterPickup(this);
+		}
+	}
 }
 
 void AAmmo::SetItemProperties(EItemState State)
 {
 	Super::SetItemProperties(State);
 
-	switch (State)
-	{
-	case EItemState::EIS_PickUp:
-		// If A PickUp
-		/* Set SkeletalMesh properties: */
-		AmmoMesh->SetSimulatePhysics(false);
-		AmmoMesh->SetEnableGravity(false);
-		AmmoMesh->SetVisibility(true);
-		AmmoMesh->SetCollisionResponseToAllChannels(ECR_Ignore);
-		AmmoMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		break;
-	case EItemState::EIS_Equipped:
-
-		// If Equipped
-		/* Set SkeletalMesh Properties*/
-		AmmoMesh->SetSimulatePhysics(false);
-		AmmoMesh->SetEnableGravity(false);
-		AmmoMesh->SetVisibility(true);
-		AmmoMesh->SetCollisionResponseToAllChannels(ECR_Ignore);
-		AmmoMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		break;
-	case EItemState::EIS_Falling:
-		// Set Mesh Properties
-		AmmoMesh->SetSimulatePhysics(true);
-		AmmoMesh->SetEnableGravity(true);
-		AmmoMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-		AmmoMesh->SetCollisionResponseToAllChannels(ECR_Ignore);
-		AmmoMesh->SetCollisionResponseToChannel(ECC_WorldStatic, ECR_Block);
-		break;
-	case EItemState::EIS_EquipInterping:
-
-		// If Equipped
-		/* Set SkeletalMesh Properties*/
-		AmmoMesh->SetSimulatePhysics(false);
-		AmmoMesh->SetEnableGravity(false);
-		AmmoMesh->SetVisibility(true);
-		AmmoMesh->SetCollisionResponseToAllChannels(ECR_Ignore);
-		AmmoMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		break;
-		/* TODO : Finish All Cases */
-
-		/* FIXME Add Cases Here please */
-
-	default:
-		// If A PickUp
-		/* Set SkeletalMesh properties: */
-		AmmoMesh->SetSimulatePhysics(false);
-		AmmoMesh->SetVisibility(true);
-		AmmoMesh->SetCollisionResponseToAllChannels(ECR_Ignore);
-		AmmoMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		break;
-	}
+	// The ammo mesh stays visible in every state
+	ApplyMeshStateProfile(AmmoMesh, GetItemStateProfile(State), true);
 }
 
 void AAmmo::EnableCustomDepth()
@@ -18,8 +18,6 @@ class SHOOTER_API AAmmo : public AItem
 public:
 	AAmmo();
 
-	virtual void Tick(float DeltaSeconds) override;
-
 private:
 	/** Mesh for the Ammo Pick up */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Ammo", meta=(AllowPrivateAccess="true"))
@@ -37,6 +35,10 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Ammo", meta=(AllowPrivateAccess="true"))
 	class USphereComponent* AmmoCollisionSphere;
 
+	/** Let the pickup manager draw this ammo as an instance while no player is near */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Ammo", meta=(AllowPrivateAccess="true"))
+	bool bCanBeDormant;
+
 protected:
 	virtual void BeginPlay() override;
 
@@ -51,6 +53,8 @@ public:
 
 	FORCEINLINE EAmmoType GetAmmoType() const { return AmmoType; }
 
+	FORCEINLINE void SetAmmoType(EAmmoType Type) { AmmoType = Type; }
+
 #pragma endregion
 
 #pragma region  CustomDepth
@@ -0,0 +1,24 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "BTTask_EnemyAttack.h"
+
+#include "AIController.h"
+#include "CooldownComponent.h"
+#include "Enemy.h"
+
+UBTTask_EnemyAttack::UBTTask_EnemyAttack():
+	PlayRate(1.f)
+{
+	NodeName = TEXT("Enemy Attack");
+}
+
+EBTNodeResult::Type UBTTask_EnemyAttack::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	const AAIController* AIController = OwnerComp.GetAIOwner();
+	AEnemy* Enemy = AIController ? Cast<AEnemy>(AIController->GetPawn()) : nullptr;
+	if (Enemy == nullptr || !Enemy->Cooldowns->IsReady(ECooldown::ECD_AttackWait)) return EBTNodeResult::Failed;
+
+	Enemy->PlayAttackMontage(Enemy->GetAttackSectionName(), PlayRate);
+	return EBTNodeResult::Succeeded;
+}
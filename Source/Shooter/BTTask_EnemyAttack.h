@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTTaskNode.h"
+#include "BTTask_EnemyAttack.generated.h"
+
+/**
+ * Play a random attack section of the enemy attack montage, fails while the attack is on cooldown.
+ * Meant to take the place of the BTT_Attack blueprint task, EnemyBehaviorTree still points at BTT_Attack
+ */
+UCLASS()
+class SHOOTER_API UBTTask_EnemyAttack : public UBTTaskNode
+{
+	GENERATED_BODY()
+
+public:
+	UBTTask_EnemyAttack();
+
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+
+private:
+	/** Play rate of the attack montage */
+	UPROPERTY(EditAnywhere, Category="Combat")
+	float PlayRate;
+};
@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "BTTask_EnemyChase.h"
+
+#include "EnemyController.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+
+UBTTask_EnemyChase::UBTTask_EnemyChase()
+{
+	NodeName = TEXT("Enemy Chase");
+}
+
+EPathFollowingRequestResult::Type UBTTask_EnemyChase::RequestMove(UBehaviorTreeComponent& OwnerComp,
+                                                                  uint8* NodeMemory,
+                                                                  AEnemyController* EnemyController)
+{
+	AActor* Target = GetTarget(OwnerComp, EnemyController);
+	if (Target == nullptr) return EPathFollowingRequestResult::Failed;
+
+	return EnemyController->MoveToActor(Target, AcceptanceRadius);
+}
+
+bool UBTTask_EnemyChase::ShouldStopMove(UBehaviorTreeComponent& OwnerComp, AEnemyController* EnemyController) const
+{
+	const FEnemyBlackboardKeys& Keys = EnemyController->GetBlackboardKeys();
+	return OwnerComp.GetBlackboardComponent()->GetValue<UBlackboardKeyType_Bool>(Keys.InAttackRange);
+}
+
+AActor* UBTTask_EnemyChase::GetTarget(UBehaviorTreeComponent& OwnerComp, AEnemyController* EnemyController) const
+{
+	const FEnemyBlackboardKeys& Keys = EnemyController->GetBlackboardKeys();
+	return Cast<AActor>(OwnerComp.GetBlackboardComponent()->GetValue<UBlackboardKeyType_Object>(Keys.Target));
+}
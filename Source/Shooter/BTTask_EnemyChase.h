@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BTTask_EnemyMove.h"
+#include "BTTask_EnemyChase.generated.h"
+
+/**
+ * Follow the Target actor until the enemy is in attack range.
+ * Not in EnemyBehaviorTree yet, its chase branch still has to be switched to this task
+ */
+UCLASS()
+class SHOOTER_API UBTTask_EnemyChase : public UBTTask_EnemyMove
+{
+	GENERATED_BODY()
+
+public:
+	UBTTask_EnemyChase();
+
+protected:
+	virtual EPathFollowingRequestResult::Type RequestMove(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory,
+	                                                      AEnemyController* EnemyController) override;
+
+	virtual bool ShouldStopMove(UBehaviorTreeComponent& OwnerComp, AEnemyController* EnemyController) const override;
+
+	/** Actor of the Target key */
+	AActor* GetTarget(UBehaviorTreeComponent& OwnerComp, AEnemyController* EnemyController) const;
+};
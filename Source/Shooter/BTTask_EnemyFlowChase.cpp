@@ -0,0 +1,134 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "BTTask_EnemyFlowChase.h"
+
+#include "EnemyController.h"
+#include "FlowFieldSubsystem.h"
+
+UBTTask_EnemyFlowChase::UBTTask_EnemyFlowChase():
+	StuckDistance(50.f),
+	StuckTime(1.5f)
+{
+	NodeName = TEXT("Enemy Flow Chase");
+}
+
+EBTNodeResult::Type UBTTask_EnemyFlowChase::AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	FBTEnemyFlowChaseMemory* Memory = reinterpret_cast<FBTEnemyFlowChaseMemory*>(NodeMemory);
+	StopFollowingField(OwnerComp, Memory, Cast<AEnemyController>(OwnerComp.GetAIOwner()));
+
+	return Super::AbortTask(OwnerComp, NodeMemory);
+}
+
+uint16 UBTTask_EnemyFlowChase::GetInstanceMemorySize() const
+{
+	return sizeof(FBTEnemyFlowChaseMemory);
+}
+
+EPathFollowingRequestResult::Type UBTTask_EnemyFlowChase::RequestMove(UBehaviorTreeComponent& OwnerComp,
+                                                                      uint8* NodeMemory,
+                                                                      AEnemyController* EnemyController)
+{
+	FBTEnemyFlowChaseMemory* Memory = reinterpret_cast<FBTEnemyFlowChaseMemory*>(NodeMemory);
+	Memory->bFollowingField = false;
+	Memory->FieldRetryTime = 0.f;
+	if (TryFollowField(OwnerComp, Memory, EnemyController))
+	{
+		return EPathFollowingRequestResult::RequestSuccessful;
+	}
+	return Super::RequestMove(OwnerComp, NodeMemory, EnemyController);
+}
+
+void UBTTask_EnemyFlowChase::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+{
+	FBTEnemyFlowChaseMemory* Memory = reinterpret_cast<FBTEnemyFlowChaseMemory*>(NodeMemory);
+	AEnemyController* EnemyController = Cast<AEnemyController>(OwnerComp.GetAIOwner());
+	if (EnemyController == nullptr)
+	{
+		Super::TickTask(OwnerComp, NodeMemory, DeltaSeconds);
+		return;
+	}
+
+	// On the navmesh path, switch to the field as soon as it reaches the enemy
+	if (!Memory->bFollowingField)
+	{
+		if (!TryFollowField(OwnerComp, Memory, EnemyController))
+		{
+			Super::TickTask(OwnerComp, NodeMemory, DeltaSeconds);
+			return;
+		}
+		EnemyController->StopMovement();
+	}
+
+	if (ShouldStopMove(OwnerComp, EnemyController))
+	{
+		StopFollowingField(OwnerComp, Memory, EnemyController);
+		FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
+		return;
+	}
+
+	const UFlowFieldSubsystem* FlowField = OwnerComp.GetWorld()->GetSubsystem<UFlowFieldSubsystem>();
+	const APawn* Pawn = EnemyController->GetPawn();
+	if (FlowField && Pawn && FlowField->CanFollow(GetTarget(OwnerComp, EnemyController), Pawn->GetActorLocation()))
+	{
+		const float Time{OwnerComp.GetWorld()->GetTimeSeconds()};
+		if (!IsStuck(Memory, Pawn, Time)) return;
+
+		// Blocked by something the field missed, the navmesh path goes around it
+		Memory->FieldRetryTime = Time + StuckTime;
+	}
+
+	// Off the field or stuck on it, back to the navmesh path
+	StopFollowingField(OwnerComp, Memory, EnemyController);
+	const EPathFollowingRequestResult::Type Result{Super::RequestMove(OwnerComp, NodeMemory, EnemyController)};
+	if (Result != EPathFollowingRequestResult::RequestSuccessful)
+	{
+		const bool bAtGoal{Result == EPathFollowingRequestResult::AlreadyAtGoal};
+		FinishLatentTask(OwnerComp, bAtGoal ? EBTNodeResult::Succeeded : EBTNodeResult::Failed);
+	}
+}
+
+bool UBTTask_EnemyFlowChase::TryFollowField(UBehaviorTreeComponent& OwnerComp, FBTEnemyFlowChaseMemory* Memory,
+                                            AEnemyController* EnemyController) const
+{
+	const float Time{OwnerComp.GetWorld()->GetTimeSeconds()};
+	if (Time < Memory->FieldRetryTime) return false;
+
+	UFlowFieldSubsystem* FlowField = OwnerComp.GetWorld()->GetSubsystem<UFlowFieldSubsystem>();
+	APawn* Pawn = EnemyController->GetPawn();
+	AActor* Target = GetTarget(OwnerComp, EnemyController);
+	if (FlowField == nullptr || !FlowField->StartFollowing(Pawn, Target)) return false;
+
+	// The field only moves the pawn, face the target like the path following would
+	EnemyController->SetFocus(Target, EAIFocusPriority::Move);
+	Memory->bFollowingField = true;
+	Memory->ProgressLocation = Pawn->GetActorLocation();
+	Memory->ProgressTime = Time;
+	return true;
+}
+
+bool UBTTask_EnemyFlowChase::IsStuck(FBTEnemyFlowChaseMemory* Memory, const APawn* Pawn, float Time) const
+{
+	if (FVector::DistSquared2D(Pawn->GetActorLocation(), Memory->ProgressLocation) > FMath::Square(StuckDistance))
+	{
+		Memory->ProgressLocation = Pawn->GetActorLocation();
+		Memory->ProgressTime = Time;
+		return false;
+	}
+	return Time - Memory->ProgressTime > StuckTime;
+}
+
+void UBTTask_EnemyFlowChase::StopFollowingField(UBehaviorTreeComponent& OwnerComp, FBTEnemyFlowChaseMemory* Memory,
+                                                AEnemyController* EnemyController) const
+{
+	if (!Memory->bFollowingField) return;
+	Memory->bFollowingField = false;
+
+	UFlowFieldSubsystem* FlowField = OwnerComp.GetWorld()->GetSubsystem<UFlowFieldSubsystem>();
+	if (FlowField && EnemyController)
+	{
+		FlowField->StopFollowing(EnemyController->GetPawn());
+		EnemyController->ClearFocus(EAIFocusPriority::Move);
+	}
+}
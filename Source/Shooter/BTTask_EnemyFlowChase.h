@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BTTask_EnemyChase.h"
+#include "BTTask_EnemyFlowChase.generated.h"
+
+/** Flow chase task memory, one per enemy */
+struct FBTEnemyFlowChaseMemory
+{
+	/** Moving along the shared flow field rather than a navmesh path */
+	bool bFollowingField;
+
+	/** Where and when the enemy last moved StuckDistance along the field */
+	FVector ProgressLocation;
+	float ProgressTime;
+
+	/** The enemy keeps the navmesh path until then after getting stuck on the field */
+	float FieldRetryTime;
+};
+
+/**
+ * Chase the Target along the shared flow field, falls back to the navmesh path of the chase task
+ * while the field does not lead to the Target or does not reach the enemy, and for a while
+ * after the enemy got stuck on the field
+ */
+UCLASS()
+class SHOOTER_API UBTTask_EnemyFlowChase : public UBTTask_EnemyChase
+{
+	GENERATED_BODY()
+
+public:
+	UBTTask_EnemyFlowChase();
+
+	virtual EBTNodeResult::Type AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+
+	virtual uint16 GetInstanceMemorySize() const override;
+
+protected:
+	virtual void TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+
+	virtual EPathFollowingRequestResult::Type RequestMove(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory,
+	                                                      AEnemyController* EnemyController) override;
+
+private:
+	/** Follow the field instead of the navmesh path, false when the field does not reach the enemy */
+	bool TryFollowField(UBehaviorTreeComponent& OwnerComp, FBTEnemyFlowChaseMemory* Memory,
+	                    AEnemyController* EnemyController) const;
+
+	void StopFollowingField(UBehaviorTreeComponent& OwnerComp, FBTEnemyFlowChaseMemory* Memory,
+	                        AEnemyController* EnemyController) const;
+
+	/** True when the pawn did not move StuckDistance along the field for StuckTime */
+	bool IsStuck(FBTEnemyFlowChaseMemory* Memory, const APawn* Pawn, float Time) const;
+
+	/** Distance the enemy must move along the field to count as making progress */
+	UPROPERTY(EditAnywhere, Category="Movement")
+	float StuckDistance;
+
+	/** Seconds without progress before the enemy leaves the field, also how long it keeps the navmesh path */
+	UPROPERTY(EditAnywhere, Category="Movement")
+	float StuckTime;
+};
@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "BTTask_EnemyMove.h"
+
+#include "EnemyController.h"
+#include "Navigation/PathFollowingComponent.h"
+
+UBTTask_EnemyMove::UBTTask_EnemyMove():
+	AcceptanceRadius(50.f)
+{
+	bNotifyTick = true;
+}
+
+EBTNodeResult::Type UBTTask_EnemyMove::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	AEnemyController* EnemyController = Cast<AEnemyController>(OwnerComp.GetAIOwner());
+	if (EnemyController == nullptr) return EBTNodeResult::Failed;
+
+	switch (RequestMove(OwnerComp, NodeMemory, EnemyController))
+	{
+	case EPathFollowingRequestResult::AlreadyAtGoal:
+		return EBTNodeResult::Succeeded;
+	case EPathFollowingRequestResult::RequestSuccessful:
+		return EBTNodeResult::InProgress;
+	default:
+		return EBTNodeResult::Failed;
+	}
+}
+
+EBTNodeResult::Type UBTTask_EnemyMove::AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	if (AAIController* AIController = OwnerComp.GetAIOwner())
+	{
+		AIController->StopMovement();
+	}
+	return EBTNodeResult::Aborted;
+}
+
+void UBTTask_EnemyMove::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+{
+	AEnemyController* EnemyController = Cast<AEnemyController>(OwnerComp.GetAIOwner());
+	if (EnemyController == nullptr)
+	{
+		FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
+		return;
+	}
+
+	if (ShouldStopMove(OwnerComp, EnemyController))
+	{
+		EnemyController->StopMovement();
+		FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
+		return;
+	}
+
+	if (EnemyController->GetMoveStatus() == EPathFollowingStatus::Idle)
+	{
+		const bool bReachedGoal{EnemyController->GetPathFollowingComponent()->DidMoveReachGoal()};
+		FinishLatentTask(OwnerComp, bReachedGoal ? EBTNodeResult::Succeeded : EBTNodeResult::Failed);
+	}
+}
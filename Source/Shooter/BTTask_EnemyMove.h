@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AITypes.h"
+#include "BehaviorTree/BTTaskNode.h"
+#include "BTTask_EnemyMove.generated.h"
+
+/**
+ * Base of the native enemy move tasks, requests the move on execute and
+ * finishes once the path following goes idle or ShouldStopMove says so.
+ * Content/_Game/EnemyController/EnemyBehaviorTree still runs its original nodes,
+ * none of the native tasks runs until the asset is rewired to them
+ */
+UCLASS(Abstract)
+class SHOOTER_API UBTTask_EnemyMove : public UBTTaskNode
+{
+	GENERATED_BODY()
+
+public:
+	UBTTask_EnemyMove();
+
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+
+	virtual EBTNodeResult::Type AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+
+protected:
+	virtual void TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+
+	/** Start the move of the enemy */
+	virtual EPathFollowingRequestResult::Type RequestMove(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory,
+	                                                      class AEnemyController* EnemyController)
+	PURE_VIRTUAL(UBTTask_EnemyMove::RequestMove, return EPathFollowingRequestResult::Failed;);
+
+	/** True when the task succeeds before the move reaches its goal */
+	virtual bool ShouldStopMove(UBehaviorTreeComponent& OwnerComp, AEnemyController* EnemyController) const
+	{
+		return false;
+	}
+
+	/** Distance to the goal at which the move is done */
+	UPROPERTY(EditAnywhere, Category="Movement")
+	float AcceptanceRadius;
+};
@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "BTTask_EnemyPatrol.h"
+
+#include "EnemyController.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
+
+UBTTask_EnemyPatrol::UBTTask_EnemyPatrol()
+{
+	NodeName = TEXT("Enemy Patrol");
+}
+
+uint16 UBTTask_EnemyPatrol::GetInstanceMemorySize() const
+{
+	return sizeof(FBTEnemyPatrolMemory);
+}
+
+EPathFollowingRequestResult::Type UBTTask_EnemyPatrol::RequestMove(UBehaviorTreeComponent& OwnerComp,
+                                                                   uint8* NodeMemory,
+                                                                   AEnemyController* EnemyController)
+{
+	FBTEnemyPatrolMemory* Memory = reinterpret_cast<FBTEnemyPatrolMemory*>(NodeMemory);
+	const FEnemyBlackboardKeys& Keys = EnemyController->GetBlackboardKeys();
+
+	const FBlackboard::FKey PatrolPointKey{Memory->bToPatrolPointTwo ? Keys.PatrolPointTwo : Keys.PatrolPoint};
+	const FVector PatrolPoint{OwnerComp.GetBlackboardComponent()->GetValue<UBlackboardKeyType_Vector>(PatrolPointKey)};
+	Memory->bToPatrolPointTwo = !Memory->bToPatrolPointTwo;
+
+	return EnemyController->MoveToLocation(PatrolPoint, AcceptanceRadius);
+}
@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BTTask_EnemyMove.h"
+#include "BTTask_EnemyPatrol.generated.h"
+
+/** Patrol task memory, one per enemy */
+struct FBTEnemyPatrolMemory
+{
+	/** Next move goes to PatrolPointTwo */
+	bool bToPatrolPointTwo;
+};
+
+/**
+ * Walk to the next patrol point, alternating between PatrolPoint and PatrolPointTwo.
+ * Replaces the patrol moves of EnemyBehaviorTree once the asset uses it
+ */
+UCLASS()
+class SHOOTER_API UBTTask_EnemyPatrol : public UBTTask_EnemyMove
+{
+	GENERATED_BODY()
+
+public:
+	UBTTask_EnemyPatrol();
+
+	virtual uint16 GetInstanceMemorySize() const override;
+
+protected:
+	virtual EPathFollowingRequestResult::Type RequestMove(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory,
+	                                                      AEnemyController* EnemyController) override;
+};
@@ -5,6 +5,7 @@
 
 #include "NiagaraCommon.h"
 #include "NiagaraComponentPool.h"
+#include "PickupManagerSubsystem.h"
 #include "ShooterCharacter.h"
 #include "Components/SphereComponent.h"
 #include "Kismet/GameplayStatics.h"
@@ -16,10 +17,11 @@
 // Sets default values
 ABoostPickUp::ABoostPickUp():
 	HealingAmount(100),
-	BoostPickUpType(EBoostPickUpType::EBPT_HEALTH)
+	BoostPickUpType(EBoostPickUpType::EBPT_HEALTH),
+	bCanBeDormant(true)
 {
-	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+	// Nothing to do per frame, the pickup only reacts to overlaps
+	PrimaryActorTick.bCanEverTick = false;
 
 	PickUpMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("PickUpMesh"));
 	SetRootComponent(PickUpMesh);
@@ -40,12 +42,14 @@ void ABoostPickUp::BeginPlay()
 	OverlapSphere->OnComponentBeginOverlap.AddDynamic(this, &ABoostPickUp::OnSphereOverlap);
 
 	NiagaraComponent->GetSystemInstance()->Activate(FNiagaraSystemInstance::EResetMode::None);
-}
 
-// Called every frame
-void ABoostPickUp::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
+	if (bCanBeDormant)
+	{
+		if (UPickupManagerSubsystem* PickupManager = GetWorld()->GetSubsystem<UPickupManagerSubsystem>())
+		{
+			PickupManager->RegisterPickup(this);
+		}
+	}
 }
 
 void ABoostPickUp::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
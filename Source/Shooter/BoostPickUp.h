@@ -29,10 +29,6 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
-public:
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
-
 private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Mesh", meta=(AllowPrivateAccess="true"))
 	class UStaticMeshComponent* PickUpMesh;
@@ -60,6 +56,21 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Effect", meta=(AllowPrivateAccess="true"))
 	UNiagaraSystem* PickUpEffect;
 
+	/** Let the pickup manager draw this pickup as an instance while no player is near */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Boost", meta=(AllowPrivateAccess="true"))
+	bool bCanBeDormant;
+
+public:
+	FORCEINLINE UStaticMeshComponent* GetPickUpMesh() const { return PickUpMesh; }
+
+	FORCEINLINE EBoostPickUpType GetBoostPickUpType() const { return BoostPickUpType; }
+
+	FORCEINLINE float GetHealingAmount() const { return HealingAmount; }
+
+	FORCEINLINE void SetBoostPickUpType(EBoostPickUpType Type) { BoostPickUpType = Type; }
+
+	FORCEINLINE void SetHealingAmount(float Amount) { HealingAmount = Amount; }
+
 
 protected:
 	// Called When Overlapping Area sphere 
@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CooldownComponent.h"
+
+#include "TimerManager.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+
+UCooldownComponent::UCooldownComponent()
+{
+	// Checked against the world time, never ticks
+	PrimaryComponentTick.bCanEverTick = false;
+
+	for (uint8 Index = 0; Index < static_cast<uint8>(ECooldown::ECD_MAX); ++Index)
+	{
+		StartTimes[Index] = 0.f;
+		ReadyTimes[Index] = 0.f;
+	}
+}
+
+void UCooldownComponent::StartCooldown(ECooldown Cooldown, float Duration)
+{
+	const float Time{GetTime()};
+	StartTimes[static_cast<uint8>(Cooldown)] = Time;
+	ReadyTimes[static_cast<uint8>(Cooldown)] = Time + Duration;
+}
+
+void UCooldownComponent::StartCooldownAt(ECooldown Cooldown, float StartTime, float Duration)
+{
+	StartTimes[static_cast<uint8>(Cooldown)] = StartTime;
+	ReadyTimes[static_cast<uint8>(Cooldown)] = StartTime + Duration;
+}
+
+void UCooldownComponent::ClearCooldown(ECooldown Cooldown)
+{
+	ReadyTimes[static_cast<uint8>(Cooldown)] = GetTime();
+}
+
+bool UCooldownComponent::IsReady(ECooldown Cooldown) const
+{
+	return GetTime() >= ReadyTimes[static_cast<uint8>(Cooldown)];
+}
+
+float UCooldownComponent::GetReadyTime(ECooldown Cooldown) const
+{
+	return ReadyTimes[static_cast<uint8>(Cooldown)];
+}
+
+float UCooldownComponent::GetElapsed(ECooldown Cooldown) const
+{
+	return GetTime() - StartTimes[static_cast<uint8>(Cooldown)];
+}
+
+float UCooldownComponent::GetTime() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.f;
+}
+
+#if !UE_BUILD_SHIPPING
+namespace
+{
+	// Full auto fire into a crowd: per shot the fire, crossHair and slide gates of the character,
+	// and the hit react and attack wait gates of every enemy, first as world timers then as cooldowns
+	void BenchCooldowns(const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 EnemyCount{Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100};
+		const int32 ShotCount{Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 600};
+		if (World == nullptr || EnemyCount <= 0 || ShotCount <= 0) return;
+
+		const int32 GatesPerShot{3 + 2 * EnemyCount};
+		const FTimerDelegate EmptyDelegate{FTimerDelegate::CreateLambda([]() {})};
+		FTimerManager& TimerManager = World->GetTimerManager();
+
+		TArray<FTimerHandle> TimerHandles;
+		TimerHandles.SetNum(GatesPerShot);
+		const double TimerStart{FPlatformTime::Seconds()};
+		for (int32 Shot = 0; Shot < ShotCount; ++Shot)
+		{
+			for (FTimerHandle& TimerHandle : TimerHandles)
+			{
+				// Resetting a running timer removes it from the heap and pushes it again
+				TimerManager.SetTimer(TimerHandle, EmptyDelegate, 0.1f, false);
+			}
+		}
+		const double TimerTime{FPlatformTime::Seconds() - TimerStart};
+		for (FTimerHandle& TimerHandle : TimerHandles)
+		{
+			TimerManager.ClearTimer(TimerHandle);
+		}
+
+		UCooldownComponent* CharacterCooldowns = NewObject<UCooldownComponent>(World->GetWorldSettings());
+		TArray<UCooldownComponent*> EnemyCooldowns;
+		for (int32 Index = 0; Index < EnemyCount; ++Index)
+		{
+			EnemyCooldowns.Add(NewObject<UCooldownComponent>(World->GetWorldSettings()));
+		}
+
+		int32 ReadyCount{0};
+		const double CooldownStart{FPlatformTime::Seconds()};
+		for (int32 Shot = 0; Shot < ShotCount; ++Shot)
+		{
+			ReadyCount += CharacterCooldowns->IsReady(ECooldown::ECD_AutoFire);
+			CharacterCooldowns->StartCooldown(ECooldown::ECD_AutoFire, 0.1f);
+			CharacterCooldowns->StartCooldown(ECooldown::ECD_CrossHairShoot, 0.05f);
+			CharacterCooldowns->StartCooldown(ECooldown::ECD_Slide, 0.2f);
+			for (UCooldownComponent* Cooldowns : EnemyCooldowns)
+			{
+				ReadyCount += Cooldowns->IsReady(ECooldown::ECD_HitReact);
+				Cooldowns->StartCooldown(ECooldown::ECD_HitReact, 0.5f);
+				Cooldowns->StartCooldown(ECooldown::ECD_AttackWait, 1.f);
+			}
+		}
+		const double CooldownTime{FPlatformTime::Seconds() - CooldownStart};
+
+		UE_LOG(LogTemp, Log,
+		       TEXT("BenchCooldowns: %d enemies, %d shots, %d gates. World timers %.3f ms, cooldowns %.3f ms (%d ready)"),
+		       EnemyCount, ShotCount, ShotCount * GatesPerShot, TimerTime * 1000.0, CooldownTime * 1000.0, ReadyCount);
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs BenchCooldownsCommand(
+		TEXT("Shooter.BenchCooldowns"),
+		TEXT("Compare world timers and cooldown timestamps under full auto fire. Usage: Shooter.BenchCooldowns [Enemies] [Shots]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BenchCooldowns));
+}
+#endif
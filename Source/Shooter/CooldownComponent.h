@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "CooldownComponent.generated.h"
+
+UENUM(BlueprintType)
+enum class ECooldown : uint8
+{
+	ECD_AutoFire UMETA(DisplayName="AutoFire"),
+	ECD_CrossHairShoot UMETA(DisplayName="CrossHairShoot"),
+	ECD_PickUpSound UMETA(DisplayName="PickUpSound"),
+	ECD_EquipSound UMETA(DisplayName="EquipSound"),
+	ECD_HitReact UMETA(DisplayName="HitReact"),
+	ECD_AttackWait UMETA(DisplayName="AttackWait"),
+	ECD_Slide UMETA(DisplayName="Slide"),
+
+	ECD_MAX UMETA(DisplayName="DefaultMAX")
+};
+
+/**
+ * World times at which the gameplay cooldowns of the owner are ready again, in place of a timer each.
+ * Starting and checking a cooldown is a store and a compare, nothing runs when it ends:
+ * owners that must react poll IsReady from the tick they already have
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class SHOOTER_API UCooldownComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UCooldownComponent();
+
+	/** Not ready for Duration seconds from now, restarts a running cooldown */
+	UFUNCTION(BlueprintCallable)
+	void StartCooldown(ECooldown Cooldown, float Duration);
+
+	/** Not ready for Duration seconds from StartTime, for fixed rate cooldowns that must not drift with the frame time */
+	void StartCooldownAt(ECooldown Cooldown, float StartTime, float Duration);
+
+	/** Ready right away */
+	UFUNCTION(BlueprintCallable)
+	void ClearCooldown(ECooldown Cooldown);
+
+	UFUNCTION(BlueprintPure)
+	bool IsReady(ECooldown Cooldown) const;
+
+	/** World time the cooldown is ready */
+	float GetReadyTime(ECooldown Cooldown) const;
+
+	/** Seconds since the cooldown last started */
+	UFUNCTION(BlueprintPure)
+	float GetElapsed(ECooldown Cooldown) const;
+
+private:
+	float GetTime() const;
+
+	/** World time each cooldown last started, by ECooldown */
+	float StartTimes[static_cast<uint8>(ECooldown::ECD_MAX)];
+
+	/** World time each cooldown is ready, by ECooldown */
+	float ReadyTimes[static_cast<uint8>(ECooldown::ECD_MAX)];
+};
@@ -0,0 +1,116 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DamageQueueSubsystem.h"
+
+#include "Shooter.h"
+#include "Engine/World.h"
+#include "GameFramework/DamageType.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Events Queued"), STAT_DamageEventsQueued, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Events Applied"), STAT_DamageEventsApplied, STATGROUP_Shooter);
+DECLARE_CYCLE_STAT(TEXT("Damage Queue Resolve"), STAT_DamageQueueResolve, STATGROUP_Shooter);
+
+void UDamageQueueSubsystem::Deinitialize()
+{
+	PendingDamage.Empty();
+	PendingDamageIndices.Empty();
+	DamageLog.Empty();
+	DamageResolvedDelegate.Clear();
+
+	Super::Deinitialize();
+}
+
+void UDamageQueueSubsystem::QueueDamage(AActor* Target, float Damage, AController* EventInstigator,
+                                        AActor* DamageCauser, TSubclassOf<UDamageType> DamageTypeClass)
+{
+	if (Target == nullptr) return;
+
+	UWorld* World = Target->GetWorld();
+	UDamageQueueSubsystem* DamageQueue = World ? World->GetSubsystem<UDamageQueueSubsystem>() : nullptr;
+	if (DamageQueue)
+	{
+		DamageQueue->AddDamage(Target, Damage, EventInstigator, DamageCauser, DamageTypeClass);
+	}
+	else
+	{
+		UGameplayStatics::ApplyDamage(Target, Damage, EventInstigator, DamageCauser, DamageTypeClass);
+	}
+}
+
+void UDamageQueueSubsystem::AddDamage(AActor* Target, float Damage, AController* EventInstigator,
+                                      AActor* DamageCauser, TSubclassOf<UDamageType> DamageTypeClass)
+{
+	if (Target == nullptr || Damage == 0.f) return;
+	INC_DWORD_STAT(STAT_DamageEventsQueued);
+
+	const TPair<const AActor*, const AActor*> Pair{DamageCauser, Target};
+	if (const int32* Index = PendingDamageIndices.Find(Pair))
+	{
+		FPendingDamage& Pending = PendingDamage[*Index];
+		Pending.Damage += Damage;
+		++Pending.EventCount;
+		return;
+	}
+
+	PendingDamageIndices.Add(Pair, PendingDamage.Num());
+	FPendingDamage& Pending = PendingDamage.AddDefaulted_GetRef();
+	Pending.Target = Target;
+	Pending.DamageCauser = DamageCauser;
+	Pending.EventInstigator = EventInstigator;
+	Pending.DamageTypeClass = DamageTypeClass ? DamageTypeClass : TSubclassOf<UDamageType>(UDamageType::StaticClass());
+	Pending.Damage = Damage;
+	Pending.EventCount = 1;
+}
+
+void UDamageQueueSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_DamageQueueResolve);
+
+	// Damage dealt while resolving, e.g. by a death, waits for the next pass
+	TArray<FPendingDamage> Resolving(MoveTemp(PendingDamage));
+	PendingDamage.Reset();
+	PendingDamageIndices.Reset();
+
+	DamageLog.Reset(Resolving.Num());
+	for (const FPendingDamage& Pending : Resolving)
+	{
+		// The target may have been destroyed since the events were queued
+		AActor* Target = Pending.Target.Get();
+		if (Target == nullptr) continue;
+
+		AActor* DamageCauser = Pending.DamageCauser.Get();
+		AController* EventInstigator = Pending.EventInstigator.Get();
+		const float AppliedDamage{
+			UGameplayStatics::ApplyDamage(Target, Pending.Damage, EventInstigator, DamageCauser,
+			                              Pending.DamageTypeClass)
+		};
+
+		FDamageLogEntry& Entry = DamageLog.AddDefaulted_GetRef();
+		Entry.Target = Target;
+		Entry.DamageCauser = DamageCauser;
+		Entry.EventInstigator = EventInstigator;
+		Entry.Damage = AppliedDamage;
+		Entry.EventCount = Pending.EventCount;
+	}
+	INC_DWORD_STAT_BY(STAT_DamageEventsApplied, DamageLog.Num());
+
+	DamageResolvedDelegate.Broadcast(DamageLog);
+}
+
+ETickableTickType UDamageQueueSubsystem::GetTickableTickType() const
+{
+	// The class default object never ticks
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UDamageQueueSubsystem::IsTickable() const
+{
+	return PendingDamage.Num() > 0;
+}
+
+TStatId UDamageQueueSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDamageQueueSubsystem, STATGROUP_Tickables);
+}
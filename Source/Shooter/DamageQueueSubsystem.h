@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DamageQueueSubsystem.generated.h"
+
+/** Damage one causer dealt to one target during a frame */
+USTRUCT(BlueprintType)
+struct FDamageLogEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	class AActor* Target = nullptr;
+
+	UPROPERTY(BlueprintReadOnly)
+	AActor* DamageCauser = nullptr;
+
+	UPROPERTY(BlueprintReadOnly)
+	class AController* EventInstigator = nullptr;
+
+	/* Damage applied for all the merged events */
+	UPROPERTY(BlueprintReadOnly)
+	float Damage = 0.f;
+
+	/* Damage events merged into this entry */
+	UPROPERTY(BlueprintReadOnly)
+	int32 EventCount = 0;
+};
+
+/** Damage log of the pass that just resolved */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDamageResolvedDelegate, const TArray<FDamageLogEntry>&, DamageLog);
+
+/**
+ * Collects the damage dealt during a frame instead of applying it in the middle of the caller's logic.
+ * Events with the same causer and target are merged, then every pair takes a single ApplyDamage
+ * in one pass after the actors ticked. Each pass leaves a damage log for the UI and telemetry
+ */
+UCLASS()
+class SHOOTER_API UDamageQueueSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Queue the damage in the queue of the target's world, applied right away when the world has none */
+	static void QueueDamage(AActor* Target, float Damage, AController* EventInstigator, AActor* DamageCauser,
+	                        TSubclassOf<class UDamageType> DamageTypeClass);
+
+	/** Add to the pending damage of the causer on the target, the first event sets the instigator and damage type */
+	void AddDamage(AActor* Target, float Damage, AController* EventInstigator, AActor* DamageCauser,
+	               TSubclassOf<UDamageType> DamageTypeClass);
+
+	/** Damage resolved by the last pass */
+	FORCEINLINE const TArray<FDamageLogEntry>& GetDamageLog() const { return DamageLog; }
+
+	/** Broadcast after every pass with its damage log */
+	UPROPERTY(BlueprintAssignable, Category=Delegates)
+	FDamageResolvedDelegate DamageResolvedDelegate;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+private:
+	/* Merged damage of one causer and target pair */
+	struct FPendingDamage
+	{
+		TWeakObjectPtr<AActor> Target;
+		TWeakObjectPtr<AActor> DamageCauser;
+		TWeakObjectPtr<AController> EventInstigator;
+		TSubclassOf<UDamageType> DamageTypeClass;
+		float Damage = 0.f;
+		int32 EventCount = 0;
+	};
+
+	/* Pending damage in the order of the first event of each pair */
+	TArray<FPendingDamage> PendingDamage;
+
+	/* Index in PendingDamage of each causer and target pair */
+	TMap<TPair<const AActor*, const AActor*>, int32> PendingDamageIndices;
+
+	UPROPERTY()
+	TArray<FDamageLogEntry> DamageLog;
+};
@@ -3,17 +3,31 @@
 
 #include "Enemy.h"
 
+#include "CooldownComponent.h"
+#include "DamageQueueSubsystem.h"
 #include "EnemyController.h"
+#include "EnemyManagerSubsystem.h"
+#include "EnemyPerceptionSubsystem.h"
+#include "FXPoolSubsystem.h"
+#include "HitNumberSubsystem.h"
 #include "ShooterCharacter.h"
+#include "BrainComponent.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
 #include "Blueprint/UserWidget.h"
 #include "Components/BoxComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/SphereComponent.h"
 #include "Engine/SkeletalMeshSocket.h"
+#include "GameFramework/CharacterMovementComponent.h"
 #include "Sound/SoundCue.h"
 #include "Particles/ParticleSystemComponent.h"
+#include "PhysicsEngine/PhysicsAsset.h"
+#include "PhysicsEngine/SkeletalBodySetup.h"
 
+#include "EngineUtils.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
 
@@ -22,7 +36,6 @@ AEnemy::AEnemy():
 	Health(100.f),
 	MaxHealth(100.f),
 	HealthBarDisplayTime(4.f),
-	bCanHitReact(true),
 	HitReactTimeMin(0.5f),
 	HitReactTimeMax(3.0f),
 	HitNumberDestroyTime(1.5f),
@@ -38,10 +51,15 @@ AEnemy::AEnemy():
 	bCanAttack(true),
 	AttackWaitTime(1.f),
 	bDying(false),
-	DeathTime(4.f)
+	DeathTime(4.f),
+	bUseOverlapPerception(false),
+	EnemyManagerIndex(INDEX_NONE)
 {
-	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+	// The enemy manager runs the per frame work of every enemy
+	PrimaryActorTick.bCanEverTick = false;
+
+	// Animation rate follows the significance tier, see ApplySignificance
+	GetMesh()->bEnableUpdateRateOptimizations = true;
 
 	// Create the agroSphere 
 	AgroSphere = CreateDefaultSubobject<USphereComponent>(TEXT("AgroSphere"));
@@ -53,11 +71,18 @@ AEnemy::AEnemy():
 
 	AttackRangeSphere->SetupAttachment(GetRootComponent());
 
+	Cooldowns = CreateDefaultSubobject<UCooldownComponent>(TEXT("Cooldowns"));
+
 	LeftWeaponCollision = CreateDefaultSubobject<UBoxComponent>(TEXT("LeftWeaponBox"));
 	LeftWeaponCollision->SetupAttachment(GetMesh(), FName("LeftWeaponBone"));
 
 	RightWeaponCollision = CreateDefaultSubobject<UBoxComponent>(TEXT("RightWeaponBox"));
 	RightWeaponCollision->SetupAttachment(GetMesh(), FName("RightWeaponBone"));
+
+	for (float& Multiplier : HitZoneMultipliers)
+	{
+		Multiplier = 1.f;
+	}
 }
 
 // Called when the game starts or when spawned
@@ -65,9 +90,18 @@ void AEnemy::BeginPlay()
 {
 	Super::BeginPlay();
 
-	AgroSphere->OnComponentBeginOverlap.AddDynamic(this, &AEnemy::AgroSphereOverlap);
-	AttackRangeSphere->OnComponentBeginOverlap.AddDynamic(this, &AEnemy::AttackRangeOverlap);
-	AttackRangeSphere->OnComponentEndOverlap.AddDynamic(this, &AEnemy::AttackRangeEndOverlap);
+	if (bUseOverlapPerception)
+	{
+		AgroSphere->OnComponentBeginOverlap.AddDynamic(this, &AEnemy::AgroSphereOverlap);
+		AttackRangeSphere->OnComponentBeginOverlap.AddDynamic(this, &AEnemy::AttackRangeOverlap);
+		AttackRangeSphere->OnComponentEndOverlap.AddDynamic(this, &AEnemy::AttackRangeEndOverlap);
+	}
+	else
+	{
+		// The perception subsystem tests the ranges, the spheres only hold the radii
+		AgroSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		AttackRangeSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	}
 	// Bind Functions to overlap events for weapon boxes 
 	LeftWeaponCollision->OnComponentBeginOverlap.AddDynamic(this, &AEnemy::OnLeftWeaponOverlap);
 	RightWeaponCollision->OnComponentBeginOverlap.AddDynamic(this, &AEnemy::OnRightWeaponOverlap);
@@ -91,6 +125,9 @@ void AEnemy::BeginPlay()
 	// Ignore Camera Collision to Capsule
 	GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_Camera, ECR_Ignore);
 
+	// Resolve hit zones against the skeleton once so bullet hits only need an index lookup
+	InitializeHitZones();
+
 	// Get the AI Controller 
 	EnemyController = Cast<AEnemyController>(GetController());
 
@@ -100,19 +137,48 @@ void AEnemy::BeginPlay()
 
 	if (EnemyController)
 	{
-		EnemyController->GetBlackboardComponent()->SetValueAsVector(TEXT("PatrolPoint"), WorldPatrolPoint);
-		EnemyController->GetBlackboardComponent()->SetValueAsVector(TEXT("PatrolPointTwo"), WorldPatrolPointTwo);
-		EnemyController->GetBlackboardComponent()->SetValueAsBool(FName("CanAttack"), true);
+		UBlackboardComponent* Blackboard = EnemyController->GetBlackboardComponent();
+		const FEnemyBlackboardKeys& Keys = EnemyController->GetBlackboardKeys();
+		Blackboard->SetValue<UBlackboardKeyType_Vector>(Keys.PatrolPoint, WorldPatrolPoint);
+		Blackboard->SetValue<UBlackboardKeyType_Vector>(Keys.PatrolPointTwo, WorldPatrolPointTwo);
+		Blackboard->SetValue<UBlackboardKeyType_Bool>(Keys.CanAttack, true);
 
 
 		EnemyController->RunBehaviorTree(BehaviorTree);
 	}
+
+	if (UEnemyManagerSubsystem* EnemyManager = GetWorld()->GetSubsystem<UEnemyManagerSubsystem>())
+	{
+		EnemyManager->RegisterEnemy(this);
+	}
+
+	UEnemyPerceptionSubsystem* Perception = GetWorld()->GetSubsystem<UEnemyPerceptionSubsystem>();
+	if (Perception && !bUseOverlapPerception)
+	{
+		Perception->RegisterEnemy(this);
+	}
+}
+
+void AEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UEnemyManagerSubsystem* EnemyManager = GetWorld()->GetSubsystem<UEnemyManagerSubsystem>())
+	{
+		EnemyManager->UnregisterEnemy(this);
+	}
+	if (UEnemyPerceptionSubsystem* Perception = GetWorld()->GetSubsystem<UEnemyPerceptionSubsystem>())
+	{
+		Perception->UnregisterEnemy(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AEnemy::ShowHealthBar_Implementation()
 {
-	GetWorldTimerManager().ClearTimer(HealthBarTimer);
-	GetWorldTimerManager().SetTimer(HealthBarTimer, this, &AEnemy::HideHealthBar, HealthBarDisplayTime);
+	if (UEnemyManagerSubsystem* EnemyManager = GetWorld()->GetSubsystem<UEnemyManagerSubsystem>())
+	{
+		EnemyManager->ScheduleHideHealthBar(this, HealthBarDisplayTime);
+	}
 }
 
 void AEnemy::Die()
@@ -141,7 +207,8 @@ void AEnemy::Die()
 		if (EnemyController)
 		{
 			AnimInstance->Montage_JumpToSection(DeathMontageSectionOne);
-			EnemyController->GetBlackboardComponent()->SetValueAsBool(FName("Dead"), true);
+			EnemyController->GetBlackboardComponent()->SetValue<UBlackboardKeyType_Bool>(
+				EnemyController->GetBlackboardKeys().Dead, true);
 			EnemyController->StopMovement();
 		}
 	}
@@ -149,7 +216,7 @@ void AEnemy::Die()
 
 void AEnemy::PlayHitMontage(FName Section, float PlayRate)
 {
-	if (bCanHitReact)
+	if (Cooldowns->IsReady(ECooldown::ECD_HitReact))
 	{
 		UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
 
@@ -159,47 +226,117 @@ void AEnemy::PlayHitMontage(FName Section, float PlayRate)
 			AnimInstance->Montage_JumpToSection(Section, HitMontage);
 		}
 
-		bCanHitReact = false;
 		const float HitReactTime = FMath::FRandRange(HitReactTimeMin, HitReactTimeMax);
-		GetWorldTimerManager().SetTimer(HitReactTimer, this, &AEnemy::ResetHitReactTimer, HitReactTime);
+		Cooldowns->StartCooldown(ECooldown::ECD_HitReact, HitReactTime);
 	}
 }
 
-void AEnemy::ResetHitReactTimer()
+void AEnemy::InitializeHitZones()
 {
-	bCanHitReact = true;
+	BoneHitZones.Reset();
+	BodyHitZones.Reset();
+
+	const USkeletalMesh* SkeletalMesh = GetMesh()->SkeletalMesh;
+	if (SkeletalMesh == nullptr) return;
+
+	// Zones explicitly set on bones
+	const FReferenceSkeleton& RefSkeleton = SkeletalMesh->GetRefSkeleton();
+	TArray<int8> ExplicitZones;
+	ExplicitZones.Init(INDEX_NONE, RefSkeleton.GetNum());
+
+	bool bHeadZoneListed = false;
+	for (const FHitZoneDefinition& HitZone : HitZones)
+	{
+		if (HitZone.Zone == EHitZone::EHZ_MAX) continue;
+
+		HitZoneMultipliers[static_cast<uint8>(HitZone.Zone)] = HitZone.DamageMultiplier;
+		bHeadZoneListed |= HitZone.Zone == EHitZone::EHZ_Head;
+		for (const FName& Bone : HitZone.Bones)
+		{
+			const int32 BoneIndex = RefSkeleton.FindBoneIndex(Bone);
+			if (BoneIndex != INDEX_NONE)
+			{
+				ExplicitZones[BoneIndex] = static_cast<int8>(HitZone.Zone);
+			}
+		}
+	}
+	if (!bHeadZoneListed)
+	{
+		const int32 HeadBoneIndex = RefSkeleton.FindBoneIndex(FName(*HeadBone));
+		if (HeadBoneIndex != INDEX_NONE)
+		{
+			ExplicitZones[HeadBoneIndex] = static_cast<int8>(EHitZone::EHZ_Head);
+		}
+	}
+
+	// Parents come before their children in the reference skeleton, children inherit the parent zone
+	BoneHitZones.SetNumUninitialized(RefSkeleton.GetNum());
+	for (int32 BoneIndex = 0; BoneIndex < RefSkeleton.GetNum(); ++BoneIndex)
+	{
+		const int32 ParentIndex = RefSkeleton.GetParentIndex(BoneIndex);
+		if (ExplicitZones[BoneIndex] != INDEX_NONE)
+		{
+			BoneHitZones[BoneIndex] = static_cast<EHitZone>(ExplicitZones[BoneIndex]);
+		}
+		else
+		{
+			BoneHitZones[BoneIndex] = ParentIndex != INDEX_NONE ? BoneHitZones[ParentIndex] : EHitZone::EHZ_Body;
+		}
+	}
+
+	// Bullet traces report the physics body index in the hit item
+	const UPhysicsAsset* PhysicsAsset = GetMesh()->GetPhysicsAsset();
+	if (PhysicsAsset)
+	{
+		BodyHitZones.SetNumUninitialized(PhysicsAsset->SkeletalBodySetups.Num());
+		for (int32 BodyIndex = 0; BodyIndex < PhysicsAsset->SkeletalBodySetups.Num(); ++BodyIndex)
+		{
+			const USkeletalBodySetup* BodySetup = PhysicsAsset->SkeletalBodySetups[BodyIndex];
+			const int32 BoneIndex = BodySetup ? RefSkeleton.FindBoneIndex(BodySetup->BoneName) : INDEX_NONE;
+			BodyHitZones[BodyIndex] = BoneIndex != INDEX_NONE ? BoneHitZones[BoneIndex] : EHitZone::EHZ_Body;
+		}
+	}
 }
 
-void AEnemy::StoreHitNumber(UUserWidget* HitNumber, FVector Location)
+EHitZone AEnemy::GetHitZone(const FHitResult& HitResult) const
 {
-	HitNumbers.Add(HitNumber, Location);
+	if (HitResult.Component.Get() == GetMesh() && BodyHitZones.IsValidIndex(HitResult.Item))
+	{
+		return BodyHitZones[HitResult.Item];
+	}
 
-	FTimerHandle HitNumberTimer;
-	FTimerDelegate HitNumberDelegate;
+	// Not a physics body hit, fall back to the bone name
+	const int32 BoneIndex = GetMesh()->GetBoneIndex(HitResult.BoneName);
+	if (BoneHitZones.IsValidIndex(BoneIndex))
+	{
+		return BoneHitZones[BoneIndex];
+	}
+	return EHitZone::EHZ_Body;
+}
 
-	HitNumberDelegate.BindUFunction(this, FName("DestroyHitNumber"), HitNumber);
+UUserWidget* AEnemy::AcquireHitNumber(TSubclassOf<UUserWidget> WidgetClass)
+{
+	UHitNumberSubsystem* HitNumberSubsystem = GetWorld()->GetSubsystem<UHitNumberSubsystem>();
+	if (HitNumberSubsystem == nullptr) return nullptr;
 
-	GetWorld()->GetTimerManager().SetTimer(HitNumberTimer, HitNumberDelegate, HitNumberDestroyTime, false);
+	return HitNumberSubsystem->AcquireHitNumber(WidgetClass);
 }
 
-void AEnemy::DestroyHitNumber(UUserWidget* HitNumber)
+void AEnemy::StoreHitNumber(UUserWidget* HitNumber, FVector Location)
 {
-	HitNumbers.Remove(HitNumber);
-	HitNumber->RemoveFromParent();
+	UHitNumberSubsystem* HitNumberSubsystem = GetWorld()->GetSubsystem<UHitNumberSubsystem>();
+	if (HitNumberSubsystem == nullptr) return;
+
+	HitNumberSubsystem->AddHitNumber(HitNumber, Location, HitNumberDestroyTime);
 }
 
-void AEnemy::UpdateHitNumbers()
+void AEnemy::ShowHitNumber_Implementation(int32 Damage, FVector HitLocation, bool bHeadShot)
 {
-	for (auto& HitPair : HitNumbers)
-	{
-		UUserWidget* HitNumber{HitPair.Key};
-		const FVector Location{HitPair.Value};
+	UUserWidget* HitNumber = AcquireHitNumber(HitNumberClass);
+	if (HitNumber == nullptr) return;
 
-		FVector2D ScreenPosition;
-		UGameplayStatics::ProjectWorldToScreen(GetWorld()->GetFirstPlayerController(), Location, ScreenPosition);
-
-		HitNumber->SetPositionInViewport(ScreenPosition);
-	}
+	SetHitNumberText(HitNumber, Damage, bHeadShot);
+	StoreHitNumber(HitNumber, HitLocation);
 }
 
 void AEnemy::AgroSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
@@ -210,13 +347,19 @@ void AEnemy::AgroSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor*
 	const auto Character = Cast<AShooterCharacter>(OtherActor);
 	if (Character)
 	{
-		if (EnemyController)
+		SetPerceivedTarget(Character);
+	}
+}
+
+void AEnemy::SetPerceivedTarget(AShooterCharacter* Character)
+{
+	if (EnemyController)
+	{
+		if (EnemyController->GetBlackboardComponent())
 		{
-			if (EnemyController->GetBlackboardComponent())
-			{
-				// Set The value of the target black board Key
-				EnemyController->GetBlackboardComponent()->SetValueAsObject(TEXT("Target"), Character);
-			}
+			// Set The value of the target black board Key
+			EnemyController->GetBlackboardComponent()->SetValue<UBlackboardKeyType_Object>(
+				EnemyController->GetBlackboardKeys().Target, Character);
 		}
 	}
 }
@@ -227,7 +370,8 @@ void AEnemy::SetStunned(bool Stunned)
 	if (EnemyController)
 	{
 		// Set The value of the target black board Key
-		EnemyController->GetBlackboardComponent()->SetValueAsBool(TEXT("Stunned"), Stunned);
+		EnemyController->GetBlackboardComponent()->SetValue<UBlackboardKeyType_Bool>(
+			EnemyController->GetBlackboardKeys().Stunned, Stunned);
 	}
 }
 
@@ -239,11 +383,7 @@ void AEnemy::AttackRangeOverlap(UPrimitiveComponent* OverlappedComponent, AActor
 	const auto ShooterCharacter = Cast<AShooterCharacter>(OtherActor);
 	if (ShooterCharacter)
 	{
-		bInAttackRange = true;
-		if (EnemyController)
-		{
-			EnemyController->GetBlackboardComponent()->SetValueAsBool(TEXT("InAttackRange"), true);
-		}
+		SetInAttackRange(true);
 	}
 }
 
@@ -254,14 +394,30 @@ void AEnemy::AttackRangeEndOverlap(UPrimitiveComponent* OverlappedComponent, AAc
 	const auto ShooterCharacter = Cast<AShooterCharacter>(OtherActor);
 	if (ShooterCharacter)
 	{
-		bInAttackRange = false;
-		if (EnemyController)
-		{
-			EnemyController->GetBlackboardComponent()->SetValueAsBool(TEXT("InAttackRange"), false);
-		}
+		SetInAttackRange(false);
 	}
 }
 
+void AEnemy::SetInAttackRange(bool bInRange)
+{
+	bInAttackRange = bInRange;
+	if (EnemyController)
+	{
+		EnemyController->GetBlackboardComponent()->SetValue<UBlackboardKeyType_Bool>(
+			EnemyController->GetBlackboardKeys().InAttackRange, bInRange);
+	}
+}
+
+float AEnemy::GetAgroRadius() const
+{
+	return AgroSphere->GetScaledSphereRadius();
+}
+
+float AEnemy::GetAttackRangeRadius() const
+{
+	return AttackRangeSphere->GetScaledSphereRadius();
+}
+
 void AEnemy::PlayAttackMontage(FName Section, float PlayRate)
 {
 	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
@@ -272,10 +428,17 @@ void AEnemy::PlayAttackMontage(FName Section, float PlayRate)
 		AnimInstance->Montage_JumpToSection(Section);
 	}
 	bCanAttack = false;
-	GetWorldTimerManager().SetTimer(AttackWaitTimer, this, &AEnemy::ResetCanAttack, AttackWaitTime);
+	Cooldowns->StartCooldown(ECooldown::ECD_AttackWait, AttackWaitTime);
+
+	// The CanAttack key has to flip back for the behavior tree, the enemy manager does it
+	if (UEnemyManagerSubsystem* EnemyManager = GetWorld()->GetSubsystem<UEnemyManagerSubsystem>())
+	{
+		EnemyManager->ScheduleResetCanAttack(this, AttackWaitTime);
+	}
 	if (EnemyController)
 	{
-		EnemyController->GetBlackboardComponent()->SetValueAsBool(FName("CanAttack"), false);
+		EnemyController->GetBlackboardComponent()->SetValue<UBlackboardKeyType_Bool>(
+			EnemyController->GetBlackboardKeys().CanAttack, false);
 	}
 }
 
@@ -353,7 +516,7 @@ void AEnemy::DeactivateRightWeapon()
 void AEnemy::DoDamage(AShooterCharacter* Victim)
 {
 	if (Victim == nullptr)return;
-	UGameplayStatics::ApplyDamage(Victim, BaseDamage, EnemyController, this, UDamageType::StaticClass());
+	UDamageQueueSubsystem::QueueDamage(Victim, BaseDamage, EnemyController, this, UDamageType::StaticClass());
 
 	if (Victim->GetMeleeImpactCue())
 	{
@@ -367,9 +530,10 @@ void AEnemy::SpawnBlood(AShooterCharacter* Victim, FName SocketName)
 	if (Socket)
 	{
 		const FTransform SocketTransform{Socket->GetSocketTransform(GetMesh())};
-		if (Victim->GetBloodParticles())
+		UFXPoolSubsystem* FXPool = GetWorld()->GetSubsystem<UFXPoolSubsystem>();
+		if (FXPool && Victim->GetBloodParticles())
 		{
-			UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), Victim->GetBloodParticles(), SocketTransform);
+			FXPool->SpawnFX(Victim->GetBloodParticles(), SocketTransform);
 		}
 	}
 }
@@ -391,7 +555,8 @@ void AEnemy::ResetCanAttack()
 	bCanAttack = true;
 	if (EnemyController)
 	{
-		EnemyController->GetBlackboardComponent()->SetValueAsBool(FName("CanAttack"), true);
+		EnemyController->GetBlackboardComponent()->SetValue<UBlackboardKeyType_Bool>(
+			EnemyController->GetBlackboardKeys().CanAttack, true);
 	}
 }
 
@@ -399,7 +564,10 @@ void AEnemy::FinishDeath()
 {
 	GetMesh()->bPauseAnims = true;
 
-	GetWorldTimerManager().SetTimer(DeathTimer, this, &AEnemy::DestroyEnemy, DeathTime);
+	if (UEnemyManagerSubsystem* EnemyManager = GetWorld()->GetSubsystem<UEnemyManagerSubsystem>())
+	{
+		EnemyManager->ScheduleDestroy(this, DeathTime);
+	}
 
 	// We Can Do more here 
 }
@@ -409,12 +577,34 @@ void AEnemy::DestroyEnemy()
 	Destroy();
 }
 
-// Called every frame
-void AEnemy::Tick(float DeltaTime)
+void AEnemy::ApplySignificance(const FEnemySignificanceSettings& Settings)
 {
-	Super::Tick(DeltaTime);
+	GetCharacterMovement()->SetComponentTickInterval(Settings.TickInterval);
+	if (EnemyController && EnemyController->GetBrainComponent())
+	{
+		EnemyController->GetBrainComponent()->SetComponentTickInterval(Settings.TickInterval);
+	}
 
-	UpdateHitNumbers();
+	// Same frame skip at every LOD, so the tier decides the update rate of visible meshes
+	if (FAnimUpdateRateParameters* UpdateRateParams = GetMesh()->AnimUpdateRateParams)
+	{
+		UpdateRateParams->bShouldUseLodMap = true;
+		UpdateRateParams->LODToFrameSkipMap.Reset();
+		for (int32 LODIndex = 0; LODIndex < GetMesh()->GetNumLODs(); ++LODIndex)
+		{
+			UpdateRateParams->LODToFrameSkipMap.Add(LODIndex, Settings.AnimFrameSkip);
+		}
+	}
+
+	// The perception subsystem budgets itself, only overlap perception scales here
+	if (!bUseOverlapPerception) return;
+
+	// The player is out of reach of both spheres
+	const ECollisionEnabled::Type SphereCollision{
+		Settings.bOverlapSpheres ? ECollisionEnabled::QueryOnly : ECollisionEnabled::NoCollision
+	};
+	AgroSphere->SetCollisionEnabled(SphereCollision);
+	AttackRangeSphere->SetCollisionEnabled(SphereCollision);
 }
 
 // Called to bind functionality to input
@@ -433,9 +623,10 @@ void AEnemy::BulletHit_Implementation(FHitResult HitResult, AActor* Shooter, ACo
 		UGameplayStatics::PlaySoundAtLocation(this, ImpactSound, GetActorLocation());
 	}
 
-	if (ImpactParticles)
+	UFXPoolSubsystem* FXPool = GetWorld()->GetSubsystem<UFXPoolSubsystem>();
+	if (FXPool && ImpactParticles)
 	{
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ImpactParticles, HitResult.Location, FRotator(0.f), true);
+		FXPool->SpawnFX(ImpactParticles, HitResult.Location);
 	}
 }
 
@@ -447,7 +638,8 @@ float AEnemy::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AC
 	if (EnemyController)
 	{
 		// Agro character 
-		EnemyController->GetBlackboardComponent()->SetValueAsObject(FName("Target"), DamageCauser);
+		EnemyController->GetBlackboardComponent()->SetValue<UBlackboardKeyType_Object>(
+			EnemyController->GetBlackboardKeys().Target, DamageCauser);
 	}
 	if (Health - DamageAmount <= 0.f)
 	{
@@ -473,3 +665,57 @@ float AEnemy::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AC
 
 	return DamageAmount;
 }
+
+#if !UE_BUILD_SHIPPING
+namespace
+{
+	// Times the old head bone string compare against the hit zone lookup on the bones of the first enemy found
+	void BenchHitZones(const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 Iterations{Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100000};
+
+		TActorIterator<AEnemy> EnemyIt(World);
+		if (!EnemyIt || Iterations <= 0) return;
+		const AEnemy* Enemy = *EnemyIt;
+
+		// One hit result per physics body, like a bullet trace against the mesh would return
+		TArray<FHitResult> HitResults;
+		const UPhysicsAsset* PhysicsAsset = Enemy->GetMesh()->GetPhysicsAsset();
+		if (PhysicsAsset == nullptr) return;
+		for (int32 BodyIndex = 0; BodyIndex < PhysicsAsset->SkeletalBodySetups.Num(); ++BodyIndex)
+		{
+			FHitResult& HitResult = HitResults.AddDefaulted_GetRef();
+			HitResult.Component = Enemy->GetMesh();
+			HitResult.Item = BodyIndex;
+			HitResult.BoneName = PhysicsAsset->SkeletalBodySetups[BodyIndex]->BoneName;
+		}
+		if (HitResults.Num() == 0) return;
+
+		int32 StringHeadShots{0};
+		const double StringStart{FPlatformTime::Seconds()};
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			const FHitResult& HitResult = HitResults[Iteration % HitResults.Num()];
+			StringHeadShots += HitResult.BoneName.ToString() == Enemy->GetHeadBone() ? 1 : 0;
+		}
+		const double StringTime{FPlatformTime::Seconds() - StringStart};
+
+		int32 ZoneHeadShots{0};
+		const double ZoneStart{FPlatformTime::Seconds()};
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			const FHitResult& HitResult = HitResults[Iteration % HitResults.Num()];
+			ZoneHeadShots += Enemy->GetHitZone(HitResult) == EHitZone::EHZ_Head ? 1 : 0;
+		}
+		const double ZoneTime{FPlatformTime::Seconds() - ZoneStart};
+
+		UE_LOG(LogTemp, Log, TEXT("BenchHitZones: %d lookups over %d bodies, string compare %.3f ms (%d head), hit zone %.3f ms (%d head)"),
+		       Iterations, HitResults.Num(), StringTime * 1000.0, StringHeadShots, ZoneTime * 1000.0, ZoneHeadShots);
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs BenchHitZonesCommand(
+		TEXT("Shooter.BenchHitZones"),
+		TEXT("Compare the head bone string compare with the hit zone lookup. Usage: Shooter.BenchHitZones [Iterations]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BenchHitZones));
+}
+#endif
@@ -7,11 +7,68 @@
 #include "GameFramework/Character.h"
 #include "Enemy.generated.h"
 
+class UUserWidget;
+
+UENUM(BlueprintType)
+enum class EHitZone:uint8
+{
+	EHZ_Body UMETA(DisplayName="Body"),
+	EHZ_Head UMETA(DisplayName="Head"),
+	EHZ_Torso UMETA(DisplayName="Torso"),
+	EHZ_Limb UMETA(DisplayName="Limb"),
+	EHZ_MAX UMETA(DisplayName="DefaultMAX")
+};
+
+UENUM(BlueprintType)
+enum class EEnemySignificance:uint8
+{
+	EES_High UMETA(DisplayName="High"),
+	EES_Medium UMETA(DisplayName="Medium"),
+	EES_Low UMETA(DisplayName="Low"),
+	EES_MAX UMETA(DisplayName="DefaultMAX")
+};
+
+/* How much work an enemy does in one significance tier */
+struct FEnemySignificanceSettings
+{
+	/* Tick interval of the movement component and the behavior tree, 0 for every frame */
+	float TickInterval;
+
+	/* Animation frames skipped between two updates */
+	int32 AnimFrameSkip;
+
+	/* Query collision on the agro and attack range spheres, with overlap perception only */
+	bool bOverlapSpheres;
+};
+
+USTRUCT(BlueprintType)
+struct FHitZoneDefinition
+{
+	GENERATED_BODY()
+
+	/* Zone assigned to the bones, and to their children not listed in another zone */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EHitZone Zone = EHitZone::EHZ_Body;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FName> Bones;
+
+	/* Scales the weapon damage, head shot damage for the head zone */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float DamageMultiplier = 1.f;
+};
+
 UCLASS()
 class SHOOTER_API AEnemy : public ACharacter, public IBulletHitInterface
 {
 	GENERATED_BODY()
 
+	// Runs the scheduled health bar, attack reset and destroy work
+	friend class UEnemyManagerSubsystem;
+
+	// Plays the attack montage from the behavior tree
+	friend class UBTTask_EnemyAttack;
+
 public:
 	// Sets default values for this character's properties
 	AEnemy();
@@ -20,6 +77,8 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	UFUNCTION(BlueprintNativeEvent)
 	void ShowHealthBar();
 
@@ -32,15 +91,20 @@ protected:
 
 	void PlayHitMontage(FName Section, float PlayRate = 1.0f);
 
-	void ResetHitReactTimer();
+	/** Build the bone and physics body hit zone tables from HitZones */
+	void InitializeHitZones();
 
+	/** Pooled hit number widget, use instead of creating a new widget for every hit */
 	UFUNCTION(BlueprintCallable)
-	void StoreHitNumber(UUserWidget* HitNumber, FVector Location);
+	UUserWidget* AcquireHitNumber(TSubclassOf<UUserWidget> WidgetClass);
 
-	UFUNCTION()
-	void DestroyHitNumber(UUserWidget* HitNumber);
+	/** Hand the hit number to the hit number subsystem, it follows Location until HitNumberDestroyTime */
+	UFUNCTION(BlueprintCallable)
+	void StoreHitNumber(UUserWidget* HitNumber, FVector Location);
 
-	void UpdateHitNumbers();
+	/** Fill a pooled hit number widget with the damage, a recycled widget still shows the previous hit */
+	UFUNCTION(BlueprintImplementableEvent)
+	void SetHitNumberText(UUserWidget* HitNumber, int32 Damage, bool bHeadShot);
 
 	// Called when something overlaps with the agro sphere
 	UFUNCTION()
@@ -130,18 +194,30 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat", meta=(AllowPrivateAccess="true"))
 	FString HeadBone;
 
+	/** Hit zones of the skeleton, HeadBone is used as the head zone when none is listed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat", meta=(AllowPrivateAccess="true"))
+	TArray<FHitZoneDefinition> HitZones;
+
+	/** Hit zone of every bone of the mesh, by bone index */
+	TArray<EHitZone> BoneHitZones;
+
+	/** Hit zone of every physics body of the mesh, by body index */
+	TArray<EHitZone> BodyHitZones;
+
+	/** Damage multiplier of every hit zone */
+	float HitZoneMultipliers[static_cast<uint8>(EHitZone::EHZ_MAX)];
+
 	/** Time to display the health bar before toggling it   */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat", meta=(AllowPrivateAccess="true"))
 	float HealthBarDisplayTime;
 
-	FTimerHandle HealthBarTimer;
-
 	/** Animation Montage Hit and Death Animation   */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat", meta=(AllowPrivateAccess="true"))
 	UAnimMontage* HitMontage;
 
-
-	FTimerHandle HitReactTimer;
+	/** Hit react and attack wait cooldowns */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Combat", meta=(AllowPrivateAccess="true"))
+	class UCooldownComponent* Cooldowns;
 
 	/** Min time to disable hit react    */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat", meta=(AllowPrivateAccess="true"))
@@ -151,16 +227,14 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat", meta=(AllowPrivateAccess="true"))
 	float HitReactTimeMax;
 
-	bool bCanHitReact;
-
-	/** Map to store hit number widget  and there locations */
-	UPROPERTY(VisibleAnywhere, Category="Combat", meta=(AllowPrivateAccess="true"))
-	TMap<UUserWidget*, FVector> HitNumbers;
-
 	/** Time before remove a hit number from screen    */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat", meta=(AllowPrivateAccess="true"))
 	float HitNumberDestroyTime;
 
+	/** Widget shown for every hit, taken from the hit number pool */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat", meta=(AllowPrivateAccess="true"))
+	TSubclassOf<UUserWidget> HitNumberClass;
+
 	/** True when in attack range    */
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category="Combat", meta=(AllowPrivateAccess="true"))
 	bool bInAttackRange;
@@ -198,6 +272,10 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat", meta=(AllowPrivateAccess="true"))
 	USphereComponent* AttackRangeSphere;
 
+	/** Detect the player with overlap events on the agro and attack range spheres instead of the perception subsystem */
+	UPROPERTY(EditAnywhere, Category="Combat", meta=(AllowPrivateAccess="true"))
+	bool bUseOverlapPerception;
+
 	/** Attack Montage  Animation   */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat", meta=(AllowPrivateAccess="true"))
 	UAnimMontage* AttackMontage;
@@ -232,8 +310,6 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Combat", meta=(AllowPrivateAccess="true"))
 	bool bCanAttack;
 
-	FTimerHandle AttackWaitTimer;
-
 	UPROPERTY(EditAnywhere, Category="Combat", meta=(AllowPrivateAccess="true"))
 	float AttackWaitTime;
 
@@ -243,8 +319,6 @@ private:
 
 	bool bDying;
 
-	FTimerHandle DeathTimer;
-
 	// Time after death until destroy
 	UPROPERTY(EditAnywhere, Category="Combat", meta=(AllowPrivateAccess="true"))
 	float DeathTime;
@@ -252,10 +326,10 @@ private:
 
 #pragma endregion
 
-public:
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+	/** Slot in the enemy manager state arrays */
+	int32 EnemyManagerIndex;
 
+public:
 	// Called to bind functionality to input
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
@@ -267,8 +341,34 @@ public:
 
 	FORCEINLINE FString GetHeadBone() const { return HeadBone; }
 
-	UFUNCTION(BlueprintImplementableEvent)
+	/** Hit zone of the bone or physics body hit */
+	EHitZone GetHitZone(const FHitResult& HitResult) const;
+
+	FORCEINLINE float GetHitZoneMultiplier(EHitZone Zone) const
+	{
+		return HitZoneMultipliers[static_cast<uint8>(Zone)];
+	}
+
+	/** Show a pooled HitNumberClass widget at the hit location */
+	UFUNCTION(BlueprintNativeEvent)
 	void ShowHitNumber(int32 Damage, FVector HitLocation, bool bHeadShot);
+	void ShowHitNumber_Implementation(int32 Damage, FVector HitLocation, bool bHeadShot);
 
 	FORCEINLINE UBehaviorTree* GetBehaviorTree() const { return BehaviorTree; }
+
+	FORCEINLINE int32 GetEnemyManagerIndex() const { return EnemyManagerIndex; }
+
+	FORCEINLINE void SetEnemyManagerIndex(int32 Index) { EnemyManagerIndex = Index; }
+
+	/** Scale the tick rate, animation rate and overlap spheres to the significance tier */
+	void ApplySignificance(const FEnemySignificanceSettings& Settings);
+
+	/** The player entered the agro range, make it the target */
+	void SetPerceivedTarget(AShooterCharacter* Character);
+
+	void SetInAttackRange(bool bInRange);
+
+	/** Agro and attack ranges, the radius of their spheres even when the spheres do not overlap */
+	float GetAgroRadius() const;
+	float GetAttackRangeRadius() const;
 };
@@ -30,6 +30,16 @@ void AEnemyController::OnPossess(APawn* InPawn)
 		if (Enemy->GetBehaviorTree())
 		{
 			BlackboardComponent->InitializeBlackboard(*Enemy->GetBehaviorTree()->BlackboardAsset);
+
+			// Resolve the key names once, the enemy and the tasks write by ID
+			BlackboardKeys.Target = BlackboardComponent->GetKeyID(TEXT("Target"));
+			BlackboardKeys.PatrolPoint = BlackboardComponent->GetKeyID(TEXT("PatrolPoint"));
+			BlackboardKeys.PatrolPointTwo = BlackboardComponent->GetKeyID(TEXT("PatrolPointTwo"));
+			BlackboardKeys.CanAttack = BlackboardComponent->GetKeyID(TEXT("CanAttack"));
+			BlackboardKeys.InAttackRange = BlackboardComponent->GetKeyID(TEXT("InAttackRange"));
+			BlackboardKeys.Stunned = BlackboardComponent->GetKeyID(TEXT("Stunned"));
+			BlackboardKeys.Dead = BlackboardComponent->GetKeyID(TEXT("Dead"));
+			BlackboardKeys.IsCharacterDead = BlackboardComponent->GetKeyID(TEXT("IsCharacterDead"));
 		}
 	}
 }
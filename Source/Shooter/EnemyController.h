@@ -4,8 +4,22 @@
 
 #include "CoreMinimal.h"
 #include "AIController.h"
+#include "BehaviorTree/BehaviorTreeTypes.h"
 #include "EnemyController.generated.h"
 
+/** Blackboard key IDs of the enemy behavior tree, resolved once on possess */
+struct FEnemyBlackboardKeys
+{
+	FBlackboard::FKey Target = FBlackboard::InvalidKey;
+	FBlackboard::FKey PatrolPoint = FBlackboard::InvalidKey;
+	FBlackboard::FKey PatrolPointTwo = FBlackboard::InvalidKey;
+	FBlackboard::FKey CanAttack = FBlackboard::InvalidKey;
+	FBlackboard::FKey InAttackRange = FBlackboard::InvalidKey;
+	FBlackboard::FKey Stunned = FBlackboard::InvalidKey;
+	FBlackboard::FKey Dead = FBlackboard::InvalidKey;
+	FBlackboard::FKey IsCharacterDead = FBlackboard::InvalidKey;
+};
+
 /**
  * 
  */
@@ -28,8 +42,12 @@ private:
 	UPROPERTY(BlueprintReadWrite, Category="AI Behavior", meta=(AllowPrivateAccess="true"))
 	class UBehaviorTreeComponent* BehaviorTreeComponent;
 
+	FEnemyBlackboardKeys BlackboardKeys;
+
 public:
 	FORCEINLINE UBlackboardComponent* GetBlackboardComponent() const { return BlackboardComponent; }
 
 	FORCEINLINE UBehaviorTreeComponent* GetBehaviorTreeComponent() const { return BehaviorTreeComponent; }
+
+	FORCEINLINE const FEnemyBlackboardKeys& GetBlackboardKeys() const { return BlackboardKeys; }
 };
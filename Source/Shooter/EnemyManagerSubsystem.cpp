@@ -0,0 +1,289 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemyManagerSubsystem.h"
+
+#include "DrawDebugHelpers.h"
+#include "Shooter.h"
+#include "ShooterCharacter.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Managed Enemies"), STAT_ManagedEnemies, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies With Due Work"), STAT_EnemiesWithDueWork, STATGROUP_Shooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("High Significance Enemies"), STAT_HighSignificanceEnemies, STATGROUP_Shooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Medium Significance Enemies"), STAT_MediumSignificanceEnemies, STATGROUP_Shooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Low Significance Enemies"), STAT_LowSignificanceEnemies, STATGROUP_Shooter);
+DECLARE_CYCLE_STAT(TEXT("Enemy Manager Tick"), STAT_EnemyManagerTick, STATGROUP_Shooter);
+DECLARE_CYCLE_STAT(TEXT("Enemy Significance"), STAT_EnemySignificance, STATGROUP_Shooter);
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarEnemySignificanceDebug(
+		TEXT("Shooter.EnemySignificanceDebug"),
+		0,
+		TEXT("Draw the significance tier above every enemy. 0: off, 1: on"),
+		ECVF_Cheat);
+
+	/** Enemies closer to the player than this are in the tier, by EEnemySignificance */
+	const float SignificanceDistances[] = {2000.f, 5000.f, MAX_flt};
+
+	/** Work allowed in each tier, by EEnemySignificance */
+	const FEnemySignificanceSettings SignificanceSettings[] = {
+		// EES_High
+		{0.f, 0, true},
+		// EES_Medium
+		{0.1f, 1, true},
+		// EES_Low, beyond the reach of the spheres
+		{0.5f, 3, false},
+	};
+
+	const FColor SignificanceColors[] = {FColor::Green, FColor::Yellow, FColor::Red};
+
+	static_assert(UE_ARRAY_COUNT(SignificanceSettings) == static_cast<uint8>(EEnemySignificance::EES_MAX),
+		"Every significance tier needs settings");
+}
+
+UEnemyManagerSubsystem::UEnemyManagerSubsystem():
+	SignificanceInterval(0.25f),
+	TimeSinceSignificanceUpdate(0.f)
+{
+}
+
+void UEnemyManagerSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_ManagedEnemies, EnemyStates.Num());
+	SET_DWORD_STAT(STAT_HighSignificanceEnemies, 0);
+	SET_DWORD_STAT(STAT_MediumSignificanceEnemies, 0);
+	SET_DWORD_STAT(STAT_LowSignificanceEnemies, 0);
+	EnemyStates.Empty();
+	NextWorkTimes.Empty();
+
+	Super::Deinitialize();
+}
+
+void UEnemyManagerSubsystem::RegisterEnemy(AEnemy* Enemy)
+{
+	if (Enemy == nullptr || FindEnemy(Enemy) != INDEX_NONE) return;
+
+	FEnemyState& State = EnemyStates.AddDefaulted_GetRef();
+	State.Enemy = Enemy;
+	NextWorkTimes.Add(MAX_flt);
+	Enemy->SetEnemyManagerIndex(EnemyStates.Num() - 1);
+	INC_DWORD_STAT(STAT_ManagedEnemies);
+}
+
+void UEnemyManagerSubsystem::UnregisterEnemy(AEnemy* Enemy)
+{
+	const int32 Index{FindEnemy(Enemy)};
+	if (Index == INDEX_NONE) return;
+
+	RemoveAt(Index);
+	Enemy->SetEnemyManagerIndex(INDEX_NONE);
+}
+
+void UEnemyManagerSubsystem::ScheduleHideHealthBar(AEnemy* Enemy, float Delay)
+{
+	const int32 Index{FindEnemy(Enemy)};
+	if (Index == INDEX_NONE) return;
+
+	EnemyStates[Index].HealthBarHideTime = GetWorld()->GetTimeSeconds() + Delay;
+	UpdateNextWorkTime(Index);
+}
+
+void UEnemyManagerSubsystem::ScheduleResetCanAttack(AEnemy* Enemy, float Delay)
+{
+	const int32 Index{FindEnemy(Enemy)};
+	if (Index == INDEX_NONE) return;
+
+	EnemyStates[Index].ResetCanAttackTime = GetWorld()->GetTimeSeconds() + Delay;
+	UpdateNextWorkTime(Index);
+}
+
+void UEnemyManagerSubsystem::ScheduleDestroy(AEnemy* Enemy, float Delay)
+{
+	const int32 Index{FindEnemy(Enemy)};
+	if (Index == INDEX_NONE) return;
+
+	EnemyStates[Index].DestroyTime = GetWorld()->GetTimeSeconds() + Delay;
+	UpdateNextWorkTime(Index);
+}
+
+void UEnemyManagerSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyManagerTick);
+
+	const float TimeSeconds{GetWorld()->GetTimeSeconds()};
+
+	// Gather the due work first, destroying an enemy removes it from the arrays
+	TArray<AEnemy*, TInlineAllocator<16>> HideHealthBars;
+	TArray<AEnemy*, TInlineAllocator<16>> ResetCanAttacks;
+	TArray<AEnemy*, TInlineAllocator<16>> Destroys;
+	for (int32 Index = NextWorkTimes.Num() - 1; Index >= 0; --Index)
+	{
+		if (NextWorkTimes[Index] > TimeSeconds) continue;
+
+		FEnemyState& State = EnemyStates[Index];
+		AEnemy* Enemy = State.Enemy.Get();
+		if (Enemy == nullptr)
+		{
+			RemoveAt(Index);
+			continue;
+		}
+		INC_DWORD_STAT(STAT_EnemiesWithDueWork);
+
+		if (State.HealthBarHideTime <= TimeSeconds)
+		{
+			State.HealthBarHideTime = MAX_flt;
+			HideHealthBars.Add(Enemy);
+		}
+		if (State.ResetCanAttackTime <= TimeSeconds)
+		{
+			State.ResetCanAttackTime = MAX_flt;
+			ResetCanAttacks.Add(Enemy);
+		}
+		if (State.DestroyTime <= TimeSeconds)
+		{
+			State.DestroyTime = MAX_flt;
+			Destroys.Add(Enemy);
+		}
+		UpdateNextWorkTime(Index);
+	}
+
+	for (AEnemy* Enemy : HideHealthBars)
+	{
+		Enemy->HideHealthBar();
+	}
+	for (AEnemy* Enemy : ResetCanAttacks)
+	{
+		Enemy->ResetCanAttack();
+	}
+	for (AEnemy* Enemy : Destroys)
+	{
+		Enemy->DestroyEnemy();
+	}
+
+	TimeSinceSignificanceUpdate += DeltaTime;
+	if (TimeSinceSignificanceUpdate >= SignificanceInterval)
+	{
+		TimeSinceSignificanceUpdate = 0.f;
+		UpdateSignificance();
+	}
+}
+
+void UEnemyManagerSubsystem::UpdateSignificance()
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemySignificance);
+
+	const AShooterCharacter* ShooterCharacter = Cast<AShooterCharacter>(UGameplayStatics::GetPlayerPawn(this, 0));
+	if (ShooterCharacter == nullptr) return;
+	const FVector PlayerLocation{ShooterCharacter->GetActorLocation()};
+
+	// Enemies in each tier, by EEnemySignificance
+	uint32 TierCounts[UE_ARRAY_COUNT(SignificanceDistances)] = {};
+	for (FEnemyState& State : EnemyStates)
+	{
+		AEnemy* Enemy = State.Enemy.Get();
+		if (Enemy == nullptr) continue;
+
+		const float DistanceSquared{FVector::DistSquared(Enemy->GetActorLocation(), PlayerLocation)};
+		const EEnemySignificance Significance{GetSignificance(DistanceSquared, Enemy->WasRecentlyRendered(0.2f))};
+		if (Significance != State.Significance)
+		{
+			State.Significance = Significance;
+			Enemy->ApplySignificance(SignificanceSettings[static_cast<uint8>(Significance)]);
+		}
+
+		++TierCounts[static_cast<uint8>(Significance)];
+	}
+
+	// Tier totals of this pass, they hold until the next one
+	SET_DWORD_STAT(STAT_HighSignificanceEnemies, TierCounts[static_cast<uint8>(EEnemySignificance::EES_High)]);
+	SET_DWORD_STAT(STAT_MediumSignificanceEnemies, TierCounts[static_cast<uint8>(EEnemySignificance::EES_Medium)]);
+	SET_DWORD_STAT(STAT_LowSignificanceEnemies, TierCounts[static_cast<uint8>(EEnemySignificance::EES_Low)]);
+
+	if (CVarEnemySignificanceDebug.GetValueOnGameThread() != 0)
+	{
+		DrawSignificanceDebug();
+	}
+}
+
+EEnemySignificance UEnemyManagerSubsystem::GetSignificance(float DistanceSquared, bool bRecentlyRendered) const
+{
+	uint8 Tier{0};
+	while (Tier < static_cast<uint8>(EEnemySignificance::EES_Low) &&
+		DistanceSquared > FMath::Square(SignificanceDistances[Tier]))
+	{
+		++Tier;
+	}
+
+	// Off screen enemies drop one tier
+	if (!bRecentlyRendered && Tier < static_cast<uint8>(EEnemySignificance::EES_Low))
+	{
+		++Tier;
+	}
+	return static_cast<EEnemySignificance>(Tier);
+}
+
+void UEnemyManagerSubsystem::DrawSignificanceDebug() const
+{
+	for (const FEnemyState& State : EnemyStates)
+	{
+		AEnemy* Enemy = State.Enemy.Get();
+		if (Enemy == nullptr || State.Significance == EEnemySignificance::EES_MAX) continue;
+
+		const uint8 Tier{static_cast<uint8>(State.Significance)};
+		const FString TierName{StaticEnum<EEnemySignificance>()->GetDisplayNameTextByIndex(Tier).ToString()};
+		DrawDebugString(GetWorld(), FVector(0.f, 0.f, 120.f), TierName, Enemy,
+		                SignificanceColors[Tier], SignificanceInterval);
+	}
+}
+
+int32 UEnemyManagerSubsystem::FindEnemy(const AEnemy* Enemy) const
+{
+	if (Enemy == nullptr) return INDEX_NONE;
+
+	const int32 Index{Enemy->GetEnemyManagerIndex()};
+	if (EnemyStates.IsValidIndex(Index) && EnemyStates[Index].Enemy.Get() == Enemy)
+	{
+		return Index;
+	}
+	return INDEX_NONE;
+}
+
+void UEnemyManagerSubsystem::RemoveAt(int32 Index)
+{
+	EnemyStates.RemoveAtSwap(Index, 1, false);
+	NextWorkTimes.RemoveAtSwap(Index, 1, false);
+
+	// The last enemy moved into the hole
+	if (EnemyStates.IsValidIndex(Index))
+	{
+		if (AEnemy* MovedEnemy = EnemyStates[Index].Enemy.Get())
+		{
+			MovedEnemy->SetEnemyManagerIndex(Index);
+		}
+	}
+	DEC_DWORD_STAT(STAT_ManagedEnemies);
+}
+
+void UEnemyManagerSubsystem::UpdateNextWorkTime(int32 Index)
+{
+	const FEnemyState& State = EnemyStates[Index];
+	NextWorkTimes[Index] = FMath::Min3(State.HealthBarHideTime, State.ResetCanAttackTime, State.DestroyTime);
+}
+
+ETickableTickType UEnemyManagerSubsystem::GetTickableTickType() const
+{
+	// The class default object never ticks
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UEnemyManagerSubsystem::IsTickable() const
+{
+	return EnemyStates.Num() > 0;
+}
+
+TStatId UEnemyManagerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyManagerSubsystem, STATGROUP_Tickables);
+}
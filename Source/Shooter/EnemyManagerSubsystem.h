@@ -0,0 +1,94 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Enemy.h"
+#include "Tickable.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyManagerSubsystem.generated.h"
+
+/** Pending work of one enemy, times are world times and MAX_flt when nothing is scheduled */
+struct FEnemyState
+{
+	TWeakObjectPtr<AEnemy> Enemy;
+
+	/** Hide the health bar at this time */
+	float HealthBarHideTime = MAX_flt;
+
+	/** Let the enemy attack again at this time */
+	float ResetCanAttackTime = MAX_flt;
+
+	/** Destroy the dead enemy at this time */
+	float DestroyTime = MAX_flt;
+
+	/** Tier last applied to the enemy, MAX until the first evaluation */
+	EEnemySignificance Significance = EEnemySignificance::EES_MAX;
+};
+
+/**
+ * Ticks every enemy from a single tick function instead of one actor tick each.
+ * The state lives in contiguous arrays, the earliest pending work time of each
+ * enemy is kept apart so enemies with nothing due are skipped with one compare.
+ * Also sorts the enemies in significance tiers by distance to the player and
+ * whether they were rendered, lower tiers tick and animate less
+ */
+UCLASS()
+class SHOOTER_API UEnemyManagerSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UEnemyManagerSubsystem();
+
+	virtual void Deinitialize() override;
+
+	void RegisterEnemy(AEnemy* Enemy);
+
+	/** Safe to call for enemies that are not registered */
+	void UnregisterEnemy(AEnemy* Enemy);
+
+	/** Hide the health bar of the enemy Delay seconds from now, replaces the previous request */
+	void ScheduleHideHealthBar(AEnemy* Enemy, float Delay);
+
+	/** Let the enemy attack again Delay seconds from now, replaces the previous request */
+	void ScheduleResetCanAttack(AEnemy* Enemy, float Delay);
+
+	/** Destroy the enemy Delay seconds from now */
+	void ScheduleDestroy(AEnemy* Enemy, float Delay);
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+private:
+	/** Index of the enemy in the state arrays, INDEX_NONE if not registered */
+	int32 FindEnemy(const AEnemy* Enemy) const;
+
+	void RemoveAt(int32 Index);
+
+	/** Recompute the earliest pending work time of an enemy */
+	void UpdateNextWorkTime(int32 Index);
+
+	/** Put every enemy in its significance tier and apply the tier settings on change */
+	void UpdateSignificance();
+
+	/** Tier for the distance to the player, one tier lower when not rendered */
+	EEnemySignificance GetSignificance(float DistanceSquared, bool bRecentlyRendered) const;
+
+	/** Draw the tier above every enemy */
+	void DrawSignificanceDebug() const;
+
+	/** Seconds between two significance updates */
+	float SignificanceInterval;
+
+	float TimeSinceSignificanceUpdate;
+
+	TArray<FEnemyState> EnemyStates;
+
+	/** Earliest pending work time of each enemy, same order as EnemyStates */
+	TArray<float> NextWorkTimes;
+};
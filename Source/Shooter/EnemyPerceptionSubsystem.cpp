@@ -0,0 +1,197 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemyPerceptionSubsystem.h"
+
+#include "Enemy.h"
+#include "Shooter.h"
+#include "ShooterCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Perceiving Enemies"), STAT_PerceivingEnemies, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Perception Evaluations"), STAT_PerceptionEvaluations, STATGROUP_Shooter);
+DECLARE_CYCLE_STAT(TEXT("Enemy Perception"), STAT_EnemyPerception, STATGROUP_Shooter);
+
+UEnemyPerceptionSubsystem::UEnemyPerceptionSubsystem():
+	CellSize(2000.f),
+	EnemiesPerFrame(8),
+	MaxPerceptionRadius(0.f),
+	NextPendingEnemy(0)
+{
+}
+
+void UEnemyPerceptionSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_PerceivingEnemies, EnemyStates.Num());
+	Cells.Empty();
+	EnemyStates.Empty();
+	PendingEnemies.Empty();
+	NextPendingEnemy = 0;
+
+	Super::Deinitialize();
+}
+
+void UEnemyPerceptionSubsystem::RegisterEnemy(AEnemy* Enemy)
+{
+	if (Enemy == nullptr || EnemyStates.Contains(Enemy)) return;
+
+	FEnemyPerceptionState& State = EnemyStates.Add(Enemy);
+	State.Cell = GetCell(Enemy->GetActorLocation());
+	Cells.FindOrAdd(State.Cell).Add(Enemy);
+	MaxPerceptionRadius = FMath::Max3(MaxPerceptionRadius, Enemy->GetAgroRadius(), Enemy->GetAttackRangeRadius());
+	INC_DWORD_STAT(STAT_PerceivingEnemies);
+}
+
+void UEnemyPerceptionSubsystem::UnregisterEnemy(AEnemy* Enemy)
+{
+	FEnemyPerceptionState State;
+	if (!EnemyStates.RemoveAndCopyValue(Enemy, State)) return;
+
+	if (TArray<TWeakObjectPtr<AEnemy>>* CellEnemies = Cells.Find(State.Cell))
+	{
+		CellEnemies->RemoveSwap(Enemy);
+		if (CellEnemies->Num() == 0)
+		{
+			Cells.Remove(State.Cell);
+		}
+	}
+	DEC_DWORD_STAT(STAT_PerceivingEnemies);
+}
+
+void UEnemyPerceptionSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyPerception);
+
+	AShooterCharacter* ShooterCharacter = Cast<AShooterCharacter>(UGameplayStatics::GetPlayerPawn(this, 0));
+	if (ShooterCharacter == nullptr) return;
+	const float PlayerRadius{ShooterCharacter->GetCapsuleComponent()->GetScaledCapsuleRadius()};
+
+	bool bStartedPass{false};
+	int32 Budget{EnemiesPerFrame};
+	while (Budget > 0)
+	{
+		if (NextPendingEnemy >= PendingEnemies.Num())
+		{
+			// At most one new pass a frame, a short pass must not evaluate an enemy twice
+			if (bStartedPass) break;
+			bStartedPass = true;
+			StartPass(ShooterCharacter->GetActorLocation(), PlayerRadius);
+			if (PendingEnemies.Num() == 0) break;
+		}
+
+		AEnemy* Enemy = PendingEnemies[NextPendingEnemy++].Get();
+		FEnemyPerceptionState* State = Enemy ? EnemyStates.Find(Enemy) : nullptr;
+		if (State == nullptr) continue;
+
+		EvaluateEnemy(Enemy, *State, ShooterCharacter, PlayerRadius);
+		INC_DWORD_STAT(STAT_PerceptionEvaluations);
+		--Budget;
+	}
+}
+
+void UEnemyPerceptionSubsystem::StartPass(const FVector& PlayerLocation, float PlayerRadius)
+{
+	PendingEnemies.Reset();
+	NextPendingEnemy = 0;
+
+	// Enemies move, their cells are refreshed once per pass
+	for (TPair<TWeakObjectPtr<AEnemy>, FEnemyPerceptionState>& Pair : EnemyStates)
+	{
+		AEnemy* Enemy = Pair.Key.Get();
+		if (Enemy == nullptr) continue;
+
+		UpdateCell(Enemy, Pair.Value);
+
+		// Leaving the range must be seen even when the enemy is no longer near the player
+		if (Pair.Value.bInAgroRange || Pair.Value.bInAttackRange)
+		{
+			PendingEnemies.Add(Enemy);
+		}
+	}
+
+	const float Reach{MaxPerceptionRadius + PlayerRadius};
+	const FIntVector MinCell{GetCell(PlayerLocation - FVector(Reach))};
+	const FIntVector MaxCell{GetCell(PlayerLocation + FVector(Reach))};
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				const TArray<TWeakObjectPtr<AEnemy>>* CellEnemies = Cells.Find(FIntVector(X, Y, Z));
+				if (CellEnemies == nullptr) continue;
+
+				for (const TWeakObjectPtr<AEnemy>& Enemy : *CellEnemies)
+				{
+					const FEnemyPerceptionState* State = EnemyStates.Find(Enemy);
+					if (State && !State->bInAgroRange && !State->bInAttackRange)
+					{
+						PendingEnemies.Add(Enemy);
+					}
+				}
+			}
+		}
+	}
+}
+
+void UEnemyPerceptionSubsystem::EvaluateEnemy(AEnemy* Enemy, FEnemyPerceptionState& State,
+                                              AShooterCharacter* ShooterCharacter, float PlayerRadius) const
+{
+	// Same test as a sphere overlapping the capsule, with the capsule taken as a sphere
+	const float DistanceSquared{FVector::DistSquared(Enemy->GetActorLocation(), ShooterCharacter->GetActorLocation())};
+	const bool bInAgroRange{DistanceSquared <= FMath::Square(Enemy->GetAgroRadius() + PlayerRadius)};
+	const bool bInAttackRange{DistanceSquared <= FMath::Square(Enemy->GetAttackRangeRadius() + PlayerRadius)};
+
+	// Only entering the agro range sets the target, like the begin overlap did
+	if (bInAgroRange && !State.bInAgroRange)
+	{
+		Enemy->SetPerceivedTarget(ShooterCharacter);
+	}
+	if (bInAttackRange != State.bInAttackRange)
+	{
+		Enemy->SetInAttackRange(bInAttackRange);
+	}
+	State.bInAgroRange = bInAgroRange;
+	State.bInAttackRange = bInAttackRange;
+}
+
+void UEnemyPerceptionSubsystem::UpdateCell(AEnemy* Enemy, FEnemyPerceptionState& State)
+{
+	const FIntVector Cell{GetCell(Enemy->GetActorLocation())};
+	if (Cell == State.Cell) return;
+
+	if (TArray<TWeakObjectPtr<AEnemy>>* CellEnemies = Cells.Find(State.Cell))
+	{
+		CellEnemies->RemoveSwap(Enemy);
+		if (CellEnemies->Num() == 0)
+		{
+			Cells.Remove(State.Cell);
+		}
+	}
+	Cells.FindOrAdd(Cell).Add(Enemy);
+	State.Cell = Cell;
+}
+
+FIntVector UEnemyPerceptionSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntVector(FMath::FloorToInt(Location.X / CellSize),
+	                  FMath::FloorToInt(Location.Y / CellSize),
+	                  FMath::FloorToInt(Location.Z / CellSize));
+}
+
+ETickableTickType UEnemyPerceptionSubsystem::GetTickableTickType() const
+{
+	// The class default object never ticks
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UEnemyPerceptionSubsystem::IsTickable() const
+{
+	return EnemyStates.Num() > 0;
+}
+
+TStatId UEnemyPerceptionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyPerceptionSubsystem, STATGROUP_Tickables);
+}
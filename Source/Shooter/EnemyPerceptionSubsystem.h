@@ -0,0 +1,84 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyPerceptionSubsystem.generated.h"
+
+class AEnemy;
+class AShooterCharacter;
+
+/** What an enemy perceived of the player at its last evaluation */
+struct FEnemyPerceptionState
+{
+	/** Cell the enemy was registered in */
+	FIntVector Cell = FIntVector::ZeroValue;
+
+	bool bInAgroRange = false;
+
+	bool bInAttackRange = false;
+};
+
+/**
+ * Agro and attack range detection of the enemies without overlap events.
+ * Enemies are kept in a uniform grid, every pass queues the ones in the cells around the player
+ * and evaluates a fixed budget of them per frame in round robin order.
+ * Results go to the same Target and InAttackRange blackboard keys the spheres used to write
+ */
+UCLASS()
+class SHOOTER_API UEnemyPerceptionSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UEnemyPerceptionSubsystem();
+
+	virtual void Deinitialize() override;
+
+	void RegisterEnemy(AEnemy* Enemy);
+
+	/** Safe to call for enemies that are not registered */
+	void UnregisterEnemy(AEnemy* Enemy);
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+private:
+	FIntVector GetCell(const FVector& Location) const;
+
+	/** Move the enemy to the cell at its current location */
+	void UpdateCell(AEnemy* Enemy, FEnemyPerceptionState& State);
+
+	/** Queue the enemies near the player, and the ones still perceiving it, for the next pass */
+	void StartPass(const FVector& PlayerLocation, float PlayerRadius);
+
+	/** Compare the enemy ranges to the player and push the changes to the enemy */
+	void EvaluateEnemy(AEnemy* Enemy, FEnemyPerceptionState& State, AShooterCharacter* ShooterCharacter,
+	                   float PlayerRadius) const;
+
+	/** Size of a grid cell, about the agro radius */
+	float CellSize;
+
+	/** Enemies evaluated per frame */
+	int32 EnemiesPerFrame;
+
+	/** Largest agro or attack radius of the registered enemies */
+	float MaxPerceptionRadius;
+
+	/** Enemies registered in each grid cell */
+	TMap<FIntVector, TArray<TWeakObjectPtr<AEnemy>>> Cells;
+
+	TMap<TWeakObjectPtr<AEnemy>, FEnemyPerceptionState> EnemyStates;
+
+	/** Enemies of the current pass */
+	TArray<TWeakObjectPtr<AEnemy>> PendingEnemies;
+
+	/** Next enemy of the current pass to evaluate */
+	int32 NextPendingEnemy;
+};
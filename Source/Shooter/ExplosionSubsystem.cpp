@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ExplosionSubsystem.h"
+
+#include "Explosive.h"
+#include "Shooter.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Chain Explosions"), STAT_ChainExplosions, STATGROUP_Shooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Queued Explosions"), STAT_QueuedExplosions, STATGROUP_Shooter);
+
+UExplosionSubsystem::UExplosionSubsystem():
+	MaxExplosionsPerFrame(4)
+{
+}
+
+void UExplosionSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_QueuedExplosions, ExplosionQueue.Num());
+	ExplosionQueue.Empty();
+	QueuedExplosives.Empty();
+
+	Super::Deinitialize();
+}
+
+void UExplosionSubsystem::QueueExplosion(AExplosive* Explosive, AActor* Shooter, AController* ShooterController,
+                                         float Delay)
+{
+	if (Explosive == nullptr) return;
+
+	bool bAlreadyQueued = false;
+	QueuedExplosives.Add(Explosive, &bAlreadyQueued);
+	if (bAlreadyQueued) return;
+
+	FQueuedExplosion QueuedExplosion;
+	QueuedExplosion.Explosive = Explosive;
+	QueuedExplosion.Shooter = Shooter;
+	QueuedExplosion.ShooterController = ShooterController;
+	QueuedExplosion.ReadyTime = GetWorld()->GetTimeSeconds() + Delay;
+	ExplosionQueue.HeapPush(QueuedExplosion);
+	INC_DWORD_STAT(STAT_QueuedExplosions);
+}
+
+void UExplosionSubsystem::Tick(float DeltaTime)
+{
+	const float TimeSeconds{GetWorld()->GetTimeSeconds()};
+	int32 Explosions{0};
+	while (ExplosionQueue.Num() > 0 && ExplosionQueue.HeapTop().ReadyTime <= TimeSeconds &&
+		Explosions < MaxExplosionsPerFrame)
+	{
+		FQueuedExplosion QueuedExplosion;
+		ExplosionQueue.HeapPop(QueuedExplosion, false);
+		QueuedExplosives.Remove(QueuedExplosion.Explosive);
+		DEC_DWORD_STAT(STAT_QueuedExplosions);
+
+		// May have been shot and destroyed while waiting
+		AExplosive* Explosive = QueuedExplosion.Explosive.Get();
+		if (Explosive == nullptr || Explosive->HasExploded()) continue;
+
+		Explosive->Explode(QueuedExplosion.Shooter.Get(), QueuedExplosion.ShooterController.Get());
+		++Explosions;
+		INC_DWORD_STAT(STAT_ChainExplosions);
+	}
+}
+
+ETickableTickType UExplosionSubsystem::GetTickableTickType() const
+{
+	// The class default object never ticks
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UExplosionSubsystem::IsTickable() const
+{
+	return ExplosionQueue.Num() > 0;
+}
+
+TStatId UExplosionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UExplosionSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ExplosionSubsystem.generated.h"
+
+class AExplosive;
+
+/* An explosive waiting for its turn to explode in a chain reaction */
+struct FQueuedExplosion
+{
+	TWeakObjectPtr<AExplosive> Explosive;
+
+	/* Damage causer and instigator of the explosion that started the chain */
+	TWeakObjectPtr<AActor> Shooter;
+	TWeakObjectPtr<AController> ShooterController;
+
+	/* World time at which the explosive may explode */
+	float ReadyTime = 0.f;
+
+	bool operator<(const FQueuedExplosion& Other) const { return ReadyTime < Other.ReadyTime; }
+};
+
+/**
+ * Propagates chain reactions between explosives. Queued explosives explode once
+ * their delay has passed, at most MaxExplosionsPerFrame per frame
+ */
+UCLASS()
+class SHOOTER_API UExplosionSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UExplosionSubsystem();
+
+	virtual void Deinitialize() override;
+
+	/** Queue the explosive to explode after Delay seconds, ignored if it is already queued */
+	void QueueExplosion(AExplosive* Explosive, AActor* Shooter, AController* ShooterController, float Delay);
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+private:
+	/** Min heap on ReadyTime */
+	TArray<FQueuedExplosion> ExplosionQueue;
+
+	/** Explosives in the queue */
+	TSet<TWeakObjectPtr<AExplosive>> QueuedExplosives;
+
+	/** Max explosives exploded in a single frame, the others wait for the next frames */
+	int32 MaxExplosionsPerFrame;
+};
@@ -3,6 +3,9 @@
 
 #include "Explosive.h"
 
+#include "ExplosionSubsystem.h"
+#include "RadialDamageSubsystem.h"
+#include "FXPoolSubsystem.h"
 #include "Components/SphereComponent.h"
 #include "GameFramework/Character.h"
 #include "Kismet/GameplayStatics.h"
@@ -14,10 +17,14 @@ AExplosive::AExplosive():
 	Health(100.f),
 	MaxHealth(100.f),
 	HealthBarDisplayTime(4.f),
-	Damage(100.f)
+	Damage(100.f),
+	DamageInnerRadius(100.f),
+	MinimumDamage(10.f),
+	ChainReactionDelay(0.1f),
+	bExploded(false)
 {
-	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+	// Nothing to do per frame, the explosive only reacts to hits and damage
+	PrimaryActorTick.bCanEverTick = false;
 
 	ExplosiveMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Explosive Mesh"));
 	SetRootComponent(ExplosiveMesh);
@@ -40,6 +47,9 @@ void AExplosive::ShowHealthBar_Implementation()
 
 void AExplosive::Explode(AActor* Shooter, AController* ShooterController)
 {
+	if (bExploded) return;
+	bExploded = true;
+
 	HideHealthBar();
 
 	if (ExplodeSound)
@@ -53,29 +63,42 @@ void AExplosive::Explode(AActor* Shooter, AController* ShooterController)
 		                                         true);
 	}
 
-	TArray<AActor*> OverlappingActors;
-	//TArray<AActor*> OverlappingExplosives;
-	GetOverlappingActors(OverlappingActors, ACharacter::StaticClass());
-	//GetOverlappingActors(OverlappingExplosives, StaticClass());
-
-	for (auto Actor : OverlappingActors)
+	// Damage falls off with distance and cover, resolved asynchronously
+	URadialDamageSubsystem* RadialDamageSubsystem = GetWorld()->GetSubsystem<URadialDamageSubsystem>();
+	if (RadialDamageSubsystem)
 	{
-		UGameplayStatics::ApplyDamage(Actor, Damage, ShooterController, Shooter, UDamageType::StaticClass());
+		FRadialDamageRequest RadialDamage;
+		RadialDamage.Origin = GetActorLocation();
+		RadialDamage.BaseDamage = Damage;
+		RadialDamage.MinimumDamage = MinimumDamage;
+		RadialDamage.InnerRadius = DamageInnerRadius;
+		RadialDamage.OuterRadius = OverlapSphere->GetScaledSphereRadius();
+		RadialDamage.DamagedClass = ACharacter::StaticClass();
+		RadialDamage.DamageTypeClass = UDamageType::StaticClass();
+		RadialDamage.SourceActor = this;
+		RadialDamage.DamageCauser = Shooter;
+		RadialDamage.InstigatorController = ShooterController;
+		RadialDamageSubsystem->ApplyRadialDamage(RadialDamage);
 	}
-	/*for (auto Explo : OverlappingExplosives)
-	{
 
-		//UGameplayStatics::ApplyDamage(Explo, Damage, ShooterController, Shooter, UDamageType::StaticClass());
-		//TODO Investigate and implement chaine explosion
-	}*/
+	TArray<AActor*> OverlappingExplosives;
+	GetOverlappingActors(OverlappingExplosives, StaticClass());
 
-	Destroy();
-}
+	// Chain reaction, the explosion subsystem spreads the explosions over the next frames
+	UExplosionSubsystem* ExplosionSubsystem = GetWorld()->GetSubsystem<UExplosionSubsystem>();
+	if (ExplosionSubsystem)
+	{
+		for (auto Actor : OverlappingExplosives)
+		{
+			AExplosive* Explosive = Cast<AExplosive>(Actor);
+			if (Explosive && !Explosive->HasExploded())
+			{
+				ExplosionSubsystem->QueueExplosion(Explosive, Shooter, ShooterController, ChainReactionDelay);
+			}
+		}
+	}
 
-// Called every frame
-void AExplosive::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
+	Destroy();
 }
 
 void AExplosive::BulletHit_Implementation(FHitResult HitResult, AActor* Shooter, AController* ShooterController)
@@ -86,9 +109,10 @@ void AExplosive::BulletHit_Implementation(FHitResult HitResult, AActor* Shooter,
 		UGameplayStatics::PlaySoundAtLocation(this, ImpactSound, GetActorLocation());
 	}
 
-	if (ImpactParticles)
+	UFXPoolSubsystem* FXPool = GetWorld()->GetSubsystem<UFXPoolSubsystem>();
+	if (FXPool && ImpactParticles)
 	{
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ImpactParticles, HitResult.Location, FRotator(0.f), true);
+		FXPool->SpawnFX(ImpactParticles, HitResult.Location);
 	}
 
 	ShowHealthBar();
@@ -28,7 +28,6 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent)
 	void HideHealthBar();
 
-	void Explode(AActor* Shooter, AController* Instigator);
 private:
 	/** Particles to spawn when hit by bullets */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat", meta=(AllowPrivateAccess="true"))
@@ -72,12 +71,29 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat", meta=(AllowPrivateAccess="true"))
 	float Damage;
 
-public:
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+	/** Distance from the explosive up to which the full damage is dealt  */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat", meta=(AllowPrivateAccess="true"))
+	float DamageInnerRadius;
+
+	/** Damage dealt at the edge of the overlap sphere  */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat", meta=(AllowPrivateAccess="true"))
+	float MinimumDamage;
+
+	/** Delay before the explosives caught in this explosion explode in turn  */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat", meta=(AllowPrivateAccess="true"))
+	float ChainReactionDelay;
+
+	/** True once exploded, the actor is destroyed right after  */
+	bool bExploded;
 
+public:
 	virtual void BulletHit_Implementation(FHitResult HitResult, AActor* Shooter, AController* Instigator) override;
 
 	virtual float TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator,
 	                         AActor* DamageCauser) override;
+
+	/** Damage the characters around, queue the overlapping explosives and destroy this one */
+	void Explode(AActor* Shooter, AController* Instigator);
+
+	FORCEINLINE bool HasExploded() const { return bExploded; }
 };
@@ -0,0 +1,118 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FXPoolSubsystem.h"
+
+#include "Shooter.h"
+#include "GameFramework/WorldSettings.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled FX Components"), STAT_PooledFXComponents, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FX Spawns"), STAT_FXSpawns, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FX Spawns Over Budget"), STAT_FXSpawnsOverBudget, STATGROUP_Shooter);
+
+UFXPoolSubsystem::UFXPoolSubsystem():
+	SpawnBudgetPerFrame(32),
+	SpawnsThisFrame(0),
+	SpawnFrame(0)
+{
+}
+
+void UFXPoolSubsystem::Deinitialize()
+{
+	for (UParticleSystemComponent* Component : PooledComponents)
+	{
+		if (Component)
+		{
+			Component->DestroyComponent();
+		}
+	}
+	DEC_DWORD_STAT_BY(STAT_PooledFXComponents, PooledComponents.Num());
+	PooledComponents.Empty();
+	Pools.Empty();
+
+	Super::Deinitialize();
+}
+
+void UFXPoolSubsystem::Prewarm(UParticleSystem* System, int32 Count)
+{
+	if (System == nullptr) return;
+
+	FFXPool& Pool = Pools.FindOrAdd(System);
+	while (Pool.FreeComponents.Num() < Count)
+	{
+		UParticleSystemComponent* Component = CreatePooledComponent(System);
+		if (Component == nullptr) return;
+		Pool.FreeComponents.Add(Component);
+	}
+}
+
+UParticleSystemComponent* UFXPoolSubsystem::SpawnFX(UParticleSystem* System, const FTransform& Transform)
+{
+	if (System == nullptr) return nullptr;
+
+	// Reset the budget on a new frame
+	if (SpawnFrame != GFrameCounter)
+	{
+		SpawnFrame = GFrameCounter;
+		SpawnsThisFrame = 0;
+	}
+	if (SpawnsThisFrame >= SpawnBudgetPerFrame)
+	{
+		INC_DWORD_STAT(STAT_FXSpawnsOverBudget);
+		return nullptr;
+	}
+
+	UParticleSystemComponent* Component{nullptr};
+	FFXPool& Pool = Pools.FindOrAdd(System);
+	while (Component == nullptr && Pool.FreeComponents.Num() > 0)
+	{
+		Component = Pool.FreeComponents.Pop(false);
+	}
+	if (Component == nullptr)
+	{
+		Component = CreatePooledComponent(System);
+		if (Component == nullptr) return nullptr;
+	}
+
+	++SpawnsThisFrame;
+	INC_DWORD_STAT(STAT_FXSpawns);
+
+	// Instance parameters such as the beam Target are kept and overwritten by the caller
+	Component->SetWorldTransform(Transform, false, nullptr, ETeleportType::TeleportPhysics);
+	Component->ActivateSystem(true);
+	return Component;
+}
+
+UParticleSystemComponent* UFXPoolSubsystem::SpawnFX(UParticleSystem* System, const FVector& Location,
+                                                    const FRotator& Rotation)
+{
+	return SpawnFX(System, FTransform(Rotation, Location));
+}
+
+UParticleSystemComponent* UFXPoolSubsystem::CreatePooledComponent(UParticleSystem* System)
+{
+	UWorld* World = GetWorld();
+	if (World == nullptr || World->GetWorldSettings() == nullptr) return nullptr;
+
+	// Same outer as UGameplayStatics::SpawnEmitterAtLocation
+	UParticleSystemComponent* Component = NewObject<UParticleSystemComponent>(World->GetWorldSettings());
+	Component->bAutoActivate = false;
+	Component->bAutoDestroy = false;
+	Component->SetAbsolute(true, true, true);
+	Component->SetTemplate(System);
+	Component->OnSystemFinished.AddDynamic(this, &UFXPoolSubsystem::OnFXFinished);
+	Component->RegisterComponentWithWorld(World);
+
+	PooledComponents.Add(Component);
+	INC_DWORD_STAT(STAT_PooledFXComponents);
+	return Component;
+}
+
+void UFXPoolSubsystem::OnFXFinished(UParticleSystemComponent* Component)
+{
+	if (Component == nullptr || Component->Template == nullptr) return;
+
+	Pools.FindOrAdd(Component->Template).FreeComponents.AddUnique(Component);
+}
@@ -0,0 +1,70 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FXPoolSubsystem.generated.h"
+
+class UParticleSystem;
+class UParticleSystemComponent;
+
+/** Idle components of one particle system */
+USTRUCT()
+struct FFXPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<UParticleSystemComponent*> FreeComponents;
+};
+
+/**
+ * Recycles particle system components instead of spawning a new one for every
+ * muzzle flash, beam and impact. Pools are keyed by particle system asset and
+ * activations are capped per frame
+ */
+UCLASS()
+class SHOOTER_API UFXPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UFXPoolSubsystem();
+
+	virtual void Deinitialize() override;
+
+	/** Make sure the pool of System holds at least Count components */
+	void Prewarm(UParticleSystem* System, int32 Count);
+
+	/**
+	 * Activate a pooled component of System at the transform
+	 * @return The activated component, null when the frame spawn budget is spent
+	 */
+	UParticleSystemComponent* SpawnFX(UParticleSystem* System, const FTransform& Transform);
+
+	UParticleSystemComponent* SpawnFX(UParticleSystem* System, const FVector& Location,
+	                                  const FRotator& Rotation = FRotator::ZeroRotator);
+
+private:
+	UParticleSystemComponent* CreatePooledComponent(UParticleSystem* System);
+
+	/** Return a finished component to its pool */
+	UFUNCTION()
+	void OnFXFinished(UParticleSystemComponent* Component);
+
+	/** Pools of idle components by particle system */
+	UPROPERTY()
+	TMap<UParticleSystem*, FFXPool> Pools;
+
+	/** Every component created by the pool, active or idle */
+	UPROPERTY()
+	TArray<UParticleSystemComponent*> PooledComponents;
+
+	/** Max components activated in a single frame, extra requests are dropped */
+	int32 SpawnBudgetPerFrame;
+
+	/** Components activated during SpawnFrame */
+	int32 SpawnsThisFrame;
+	uint64 SpawnFrame;
+};
@@ -0,0 +1,430 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FlowFieldSubsystem.h"
+
+#include "NavigationSystem.h"
+#include "Shooter.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Flow Field Followers"), STAT_FlowFieldFollowers, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Flow Field Cells Expanded"), STAT_FlowFieldCellsExpanded, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Flow Field Cells Repaired"), STAT_FlowFieldCellsRepaired, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Flow Field Nav Raycasts"), STAT_FlowFieldNavRaycasts, STATGROUP_Shooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Flow Field Nav Cells"), STAT_FlowFieldNavCells, STATGROUP_Shooter);
+DECLARE_CYCLE_STAT(TEXT("Flow Field"), STAT_FlowField, STATGROUP_Shooter);
+
+namespace
+{
+	/** Neighbours the field expands to */
+	const FIntPoint ExpandOffsets[] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+
+	/** Neighbours a follower can step to, the diagonals need both sides reachable */
+	const FIntPoint StepOffsets[] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+
+	/** Index of the cell in a square grid of Size cells whose first cell is Origin, INDEX_NONE outside */
+	int32 GetGridIndex(const FIntPoint& Origin, int32 Size, const FIntPoint& Cell)
+	{
+		const FIntPoint Local{Cell - Origin};
+		if (Local.X < 0 || Local.Y < 0 || Local.X >= Size || Local.Y >= Size) return INDEX_NONE;
+		return Local.Y * Size + Local.X;
+	}
+}
+
+UFlowFieldSubsystem::UFlowFieldSubsystem():
+	CellSize(100.f),
+	FieldRadius(40),
+	CellsPerFrame(256),
+	RepairRadius(6),
+	MaxNavCells(32768),
+	NavProjectionHeight(200.f),
+	DemandTimeout(5.f),
+	LastDemandTime(-MAX_flt),
+	FieldOrigin(0, 0),
+	FieldGoalCell(0, 0),
+	FieldHeight(0.f),
+	FieldMaxDistance(0),
+	bHasField(false),
+	BuildFrontierHead(0),
+	BuildOrigin(0, 0),
+	BuildGoalCell(0, 0),
+	BuildHeight(0.f),
+	BuildMaxDistance(0),
+	bBuilding(false)
+{
+}
+
+void UFlowFieldSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_FlowFieldFollowers, Followers.Num());
+	Followers.Empty();
+	FieldDistances.Empty();
+	BuildDistances.Empty();
+	BuildFrontier.Empty();
+	RepairDistances.Empty();
+	RepairFrontier.Empty();
+	NavCells.Empty();
+	SET_DWORD_STAT(STAT_FlowFieldNavCells, 0);
+	bHasField = false;
+	bBuilding = false;
+
+	Super::Deinitialize();
+}
+
+bool UFlowFieldSubsystem::StartFollowing(APawn* Pawn, const AActor* Target)
+{
+	if (Pawn == nullptr) return false;
+
+	LastDemandTime = GetWorld()->GetTimeSeconds();
+	if (!CanFollow(Target, Pawn->GetActorLocation())) return false;
+
+	if (!Followers.Contains(Pawn))
+	{
+		Followers.Add(Pawn);
+		INC_DWORD_STAT(STAT_FlowFieldFollowers);
+	}
+	return true;
+}
+
+void UFlowFieldSubsystem::StopFollowing(APawn* Pawn)
+{
+	if (Followers.RemoveSwap(Pawn) > 0)
+	{
+		DEC_DWORD_STAT(STAT_FlowFieldFollowers);
+	}
+}
+
+bool UFlowFieldSubsystem::CanFollow(const AActor* Target, const FVector& Location) const
+{
+	return bHasField && Target && Target == Goal.Get() && GetFieldDistance(GetCell(Location)) != MAX_uint16;
+}
+
+bool UFlowFieldSubsystem::GetFlowDirection(const FVector& Location, FVector& OutDirection) const
+{
+	const FIntPoint Cell{GetCell(Location)};
+	const uint16 Distance{GetFieldDistance(Cell)};
+	if (Distance == MAX_uint16) return false;
+
+	// In the goal cell, walk straight at the goal
+	if (Distance == 0)
+	{
+		const AActor* GoalActor = Goal.Get();
+		if (GoalActor == nullptr) return false;
+		OutDirection = (GoalActor->GetActorLocation() - Location).GetSafeNormal2D();
+		return !OutDirection.IsNearlyZero();
+	}
+
+	// Step to the neighbour closest to the goal
+	FIntPoint BestOffset{0, 0};
+	uint16 BestDistance{Distance};
+	for (const FIntPoint& Offset : StepOffsets)
+	{
+		const bool bDiagonal{Offset.X != 0 && Offset.Y != 0};
+		if (bDiagonal && (GetFieldDistance(Cell + FIntPoint(Offset.X, 0)) == MAX_uint16 ||
+			GetFieldDistance(Cell + FIntPoint(0, Offset.Y)) == MAX_uint16))
+		{
+			continue;
+		}
+
+		const uint16 NeighbourDistance{GetFieldDistance(Cell + Offset)};
+		if (NeighbourDistance < BestDistance)
+		{
+			BestDistance = NeighbourDistance;
+			BestOffset = Offset;
+		}
+	}
+	if (BestOffset == FIntPoint(0, 0)) return false;
+
+	// Aim at the neighbour center so followers do not hug the walls
+	const FVector Target{
+		(Cell.X + BestOffset.X + 0.5f) * CellSize, (Cell.Y + BestOffset.Y + 0.5f) * CellSize, Location.Z
+	};
+	OutDirection = (Target - Location).GetSafeNormal2D();
+	return !OutDirection.IsNearlyZero();
+}
+
+void UFlowFieldSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlowField);
+
+	APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+	if (PlayerPawn == nullptr) return;
+
+	if (Goal.Get() != PlayerPawn)
+	{
+		Goal = PlayerPawn;
+		bHasField = false;
+	}
+
+	// A step or two to another cell on the same floor, repair the active field right away
+	const FVector GoalLocation{PlayerPawn->GetActorLocation()};
+	const FIntPoint GoalCell{GetCell(GoalLocation)};
+	const bool bSameBand{GetNavCellKey(GoalCell, GoalLocation.Z) == GetNavCellKey(GoalCell, FieldHeight)};
+	if (bHasField && bSameBand && GoalCell != FieldGoalCell)
+	{
+		RepairField(GoalCell);
+	}
+
+	// Build from scratch when the repair could not follow, or to recenter the field before the goal reaches its border
+	const FIntPoint FromCenter{GoalCell - FieldOrigin - FIntPoint(FieldRadius, FieldRadius)};
+	const bool bNearBorder{FMath::Max(FMath::Abs(FromCenter.X), FMath::Abs(FromCenter.Y)) > FieldRadius / 2};
+	if (!bBuilding && (!bHasField || !bSameBand || GoalCell != FieldGoalCell || bNearBorder))
+	{
+		StartBuild(GoalCell, GoalLocation.Z);
+	}
+	if (bBuilding)
+	{
+		ContinueBuild();
+	}
+
+	for (int32 Index = Followers.Num() - 1; Index >= 0; --Index)
+	{
+		APawn* Pawn = Followers[Index].Get();
+		if (Pawn == nullptr)
+		{
+			Followers.RemoveAtSwap(Index, 1, false);
+			DEC_DWORD_STAT(STAT_FlowFieldFollowers);
+			continue;
+		}
+
+		FVector Direction;
+		if (GetFlowDirection(Pawn->GetActorLocation(), Direction))
+		{
+			Pawn->AddMovementInput(Direction);
+		}
+	}
+}
+
+void UFlowFieldSubsystem::StartBuild(const FIntPoint& GoalCell, float GoalHeight)
+{
+	const int32 FieldSize{2 * FieldRadius + 1};
+	BuildGoalCell = GoalCell;
+	BuildOrigin = GoalCell - FIntPoint(FieldRadius, FieldRadius);
+	BuildHeight = GoalHeight;
+	BuildMaxDistance = 0;
+	BuildDistances.Init(MAX_uint16, FieldSize * FieldSize);
+	BuildFrontier.Reset();
+	BuildFrontierHead = 0;
+
+	const int32 GoalIndex{GetFieldIndex(BuildOrigin, GoalCell)};
+	BuildDistances[GoalIndex] = 0;
+	BuildFrontier.Add(GoalIndex);
+	bBuilding = true;
+
+	// Forget the cells far from the new field once the cache grew past its budget
+	if (NavCells.Num() > MaxNavCells)
+	{
+		for (auto It = NavCells.CreateIterator(); It; ++It)
+		{
+			const FIntPoint Cell{It.Key().X, It.Key().Y};
+			if (GetGridIndex(BuildOrigin - FIntPoint(FieldRadius, FieldRadius), 2 * FieldSize, Cell) == INDEX_NONE)
+			{
+				It.RemoveCurrent();
+			}
+		}
+		SET_DWORD_STAT(STAT_FlowFieldNavCells, NavCells.Num());
+	}
+}
+
+void UFlowFieldSubsystem::ContinueBuild()
+{
+	const int32 FieldSize{2 * FieldRadius + 1};
+	int32 Budget{CellsPerFrame};
+	while (Budget > 0 && BuildFrontierHead < BuildFrontier.Num())
+	{
+		const int32 Index{BuildFrontier[BuildFrontierHead++]};
+		const FIntPoint Cell{BuildOrigin.X + Index % FieldSize, BuildOrigin.Y + Index / FieldSize};
+		const uint16 NextDistance{static_cast<uint16>(BuildDistances[Index] + 1)};
+
+		for (int32 OffsetIndex = 0; OffsetIndex < static_cast<int32>(UE_ARRAY_COUNT(ExpandOffsets)); ++OffsetIndex)
+		{
+			const FIntPoint Neighbour{Cell + ExpandOffsets[OffsetIndex]};
+			const int32 NeighbourIndex{GetFieldIndex(BuildOrigin, Neighbour)};
+			if (NeighbourIndex == INDEX_NONE || BuildDistances[NeighbourIndex] != MAX_uint16) continue;
+			if (!IsConnected(Cell, OffsetIndex, BuildHeight)) continue;
+
+			BuildDistances[NeighbourIndex] = NextDistance;
+			BuildFrontier.Add(NeighbourIndex);
+			BuildMaxDistance = NextDistance;
+		}
+		INC_DWORD_STAT(STAT_FlowFieldCellsExpanded);
+		--Budget;
+	}
+
+	if (BuildFrontierHead < BuildFrontier.Num()) return;
+
+	// Done, the new field replaces the active one
+	Swap(FieldDistances, BuildDistances);
+	FieldOrigin = BuildOrigin;
+	FieldGoalCell = BuildGoalCell;
+	FieldHeight = BuildHeight;
+	FieldMaxDistance = BuildMaxDistance;
+	bHasField = true;
+	bBuilding = false;
+}
+
+bool UFlowFieldSubsystem::RepairField(const FIntPoint& GoalCell)
+{
+	// The window around the new goal has to hold the old one
+	const FIntPoint Step{GoalCell - FieldGoalCell};
+	if (FMath::Max(FMath::Abs(Step.X), FMath::Abs(Step.Y)) > RepairRadius / 2) return false;
+	if (GetFieldIndex(FieldOrigin, GoalCell) == INDEX_NONE) return false;
+
+	// Breadth first distances from the new goal inside the window
+	const int32 WindowSize{2 * RepairRadius + 1};
+	const FIntPoint WindowOrigin{GoalCell - FIntPoint(RepairRadius, RepairRadius)};
+	RepairDistances.Init(MAX_uint16, WindowSize * WindowSize);
+	RepairFrontier.Reset();
+
+	const int32 GoalIndex{GetGridIndex(WindowOrigin, WindowSize, GoalCell)};
+	RepairDistances[GoalIndex] = 0;
+	RepairFrontier.Add(GoalIndex);
+	for (int32 Head = 0; Head < RepairFrontier.Num(); ++Head)
+	{
+		const int32 Index{RepairFrontier[Head]};
+		const FIntPoint Cell{WindowOrigin.X + Index % WindowSize, WindowOrigin.Y + Index / WindowSize};
+		const uint16 NextDistance{static_cast<uint16>(RepairDistances[Index] + 1)};
+
+		for (int32 OffsetIndex = 0; OffsetIndex < static_cast<int32>(UE_ARRAY_COUNT(ExpandOffsets)); ++OffsetIndex)
+		{
+			const FIntPoint Neighbour{Cell + ExpandOffsets[OffsetIndex]};
+			const int32 NeighbourIndex{GetGridIndex(WindowOrigin, WindowSize, Neighbour)};
+			if (NeighbourIndex == INDEX_NONE || RepairDistances[NeighbourIndex] != MAX_uint16) continue;
+			if (GetFieldIndex(FieldOrigin, Neighbour) == INDEX_NONE) continue;
+			if (!IsConnected(Cell, OffsetIndex, FieldHeight)) continue;
+
+			RepairDistances[NeighbourIndex] = NextDistance;
+			RepairFrontier.Add(NeighbourIndex);
+		}
+	}
+	INC_DWORD_STAT_BY(STAT_FlowFieldCellsRepaired, RepairFrontier.Num());
+
+	// The old goal has no lower neighbour outside the window, it must get one inside
+	if (RepairDistances[GetGridIndex(WindowOrigin, WindowSize, FieldGoalCell)] == MAX_uint16) return false;
+
+	// Every old path ends in the window. Raising the cells outside by the most a window cell went up
+	// keeps each of them above the neighbour it descended to, so the field has no dip but the new goal
+	int32 Raise{0};
+	int32 WindowMaxDistance{0};
+	for (const int32 Index : RepairFrontier)
+	{
+		const FIntPoint Cell{WindowOrigin.X + Index % WindowSize, WindowOrigin.Y + Index / WindowSize};
+		const uint16 OldDistance{GetFieldDistance(Cell)};
+		if (OldDistance != MAX_uint16)
+		{
+			Raise = FMath::Max(Raise, RepairDistances[Index] - OldDistance);
+		}
+		WindowMaxDistance = FMath::Max<int32>(WindowMaxDistance, RepairDistances[Index]);
+	}
+	if (FieldMaxDistance + Raise >= MAX_uint16) return false;
+
+	if (Raise > 0)
+	{
+		for (uint16& Distance : FieldDistances)
+		{
+			if (Distance != MAX_uint16)
+			{
+				Distance = static_cast<uint16>(Distance + Raise);
+			}
+		}
+	}
+	for (const int32 Index : RepairFrontier)
+	{
+		const FIntPoint Cell{WindowOrigin.X + Index % WindowSize, WindowOrigin.Y + Index / WindowSize};
+		FieldDistances[GetFieldIndex(FieldOrigin, Cell)] = RepairDistances[Index];
+	}
+	FieldMaxDistance = FMath::Max(FieldMaxDistance + Raise, WindowMaxDistance);
+	FieldGoalCell = GoalCell;
+	return true;
+}
+
+FIntVector UFlowFieldSubsystem::GetNavCellKey(const FIntPoint& Cell, float Height) const
+{
+	return FIntVector(Cell.X, Cell.Y, FMath::FloorToInt(Height / NavProjectionHeight));
+}
+
+UFlowFieldSubsystem::FNavCell& UFlowFieldSubsystem::GetNavCell(const FIntPoint& Cell, float Height)
+{
+	const FIntVector Key{GetNavCellKey(Cell, Height)};
+	if (FNavCell* CachedCell = NavCells.Find(Key))
+	{
+		return *CachedCell;
+	}
+
+	// Project from the band center so every height of the band samples the same navmesh
+	const UNavigationSystemV1* NavSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const FVector CellCenter{
+		(Cell.X + 0.5f) * CellSize, (Cell.Y + 0.5f) * CellSize, (Key.Z + 0.5f) * NavProjectionHeight
+	};
+	const FVector Extent{CellSize * 0.5f, CellSize * 0.5f, NavProjectionHeight};
+	FNavLocation NavLocation;
+
+	FNavCell& NavCell = NavCells.Add(Key);
+	NavCell.bWalkable = NavSystem && NavSystem->ProjectPointToNavigation(CellCenter, NavLocation, Extent);
+	NavCell.NavLocation = NavLocation.Location;
+	INC_DWORD_STAT(STAT_FlowFieldNavCells);
+	return NavCell;
+}
+
+bool UFlowFieldSubsystem::IsConnected(const FIntPoint& Cell, int32 OffsetIndex, float Height)
+{
+	// Copied, adding the cell below may move the neighbour in the map
+	const FNavCell Neighbour{GetNavCell(Cell + ExpandOffsets[OffsetIndex], Height)};
+	if (!Neighbour.bWalkable) return false;
+
+	FNavCell& NavCell = GetNavCell(Cell, Height);
+	if (!NavCell.bWalkable) return false;
+
+	const uint8 EdgeBit{static_cast<uint8>(1 << OffsetIndex)};
+	if ((NavCell.CheckedEdges & EdgeBit) == 0)
+	{
+		// A wall or a ledge between the cells cuts the raycast along the navmesh
+		FVector HitLocation;
+		const bool bBlocked{
+			UNavigationSystemV1::NavigationRaycast(GetWorld(), NavCell.NavLocation, Neighbour.NavLocation, HitLocation)
+		};
+		INC_DWORD_STAT(STAT_FlowFieldNavRaycasts);
+
+		NavCell.CheckedEdges |= EdgeBit;
+		if (!bBlocked)
+		{
+			NavCell.OpenEdges |= EdgeBit;
+		}
+	}
+	return (NavCell.OpenEdges & EdgeBit) != 0;
+}
+
+FIntPoint UFlowFieldSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+int32 UFlowFieldSubsystem::GetFieldIndex(const FIntPoint& Origin, const FIntPoint& Cell) const
+{
+	return GetGridIndex(Origin, 2 * FieldRadius + 1, Cell);
+}
+
+uint16 UFlowFieldSubsystem::GetFieldDistance(const FIntPoint& Cell) const
+{
+	if (!bHasField) return MAX_uint16;
+
+	const int32 Index{GetFieldIndex(FieldOrigin, Cell)};
+	return Index == INDEX_NONE ? MAX_uint16 : FieldDistances[Index];
+}
+
+ETickableTickType UFlowFieldSubsystem::GetTickableTickType() const
+{
+	// The class default object never ticks
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UFlowFieldSubsystem::IsTickable() const
+{
+	// Only keep the field up to date while someone chases along it, or wants to
+	return Followers.Num() > 0 || GetWorld()->GetTimeSeconds() - LastDemandTime < DemandTimeout;
+}
+
+TStatId UFlowFieldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFlowFieldSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,154 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FlowFieldSubsystem.generated.h"
+
+/**
+ * One flow field toward the player shared by every chasing enemy, instead of a navmesh path each.
+ * The field is a breadth first distance grid around the player, two neighbour cells are linked
+ * only when a navmesh raycast connects them so the field does not cross thin walls or ledges.
+ * When the player changes cell the field is repaired around the old and new goal cells in the same frame.
+ * It is only rebuilt a slice per frame when the player jumps away, changes floor or nears the field border,
+ * the active field stays in use and keeps being repaired meanwhile.
+ * Followers are moved along the field every frame, enemies off the field keep using the navmesh
+ */
+UCLASS()
+class SHOOTER_API UFlowFieldSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UFlowFieldSubsystem();
+
+	virtual void Deinitialize() override;
+
+	/**
+	 * Move the pawn along the field every frame until StopFollowing.
+	 * Fails when the field does not lead to Target or does not reach the pawn,
+	 * the request still keeps the field building
+	 */
+	bool StartFollowing(APawn* Pawn, const AActor* Target);
+
+	/** Safe to call for pawns that are not following */
+	void StopFollowing(APawn* Pawn);
+
+	/** True when the field leads to Target and reaches Location */
+	bool CanFollow(const AActor* Target, const FVector& Location) const;
+
+	/** Direction to walk from Location toward the goal, false off the field */
+	bool GetFlowDirection(const FVector& Location, FVector& OutDirection) const;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+private:
+	FIntPoint GetCell(const FVector& Location) const;
+
+	/** Index of the cell in a field whose first cell is Origin, INDEX_NONE outside */
+	int32 GetFieldIndex(const FIntPoint& Origin, const FIntPoint& Cell) const;
+
+	/** Distance of the cell in the active field, MAX_uint16 when unreachable */
+	uint16 GetFieldDistance(const FIntPoint& Cell) const;
+
+	/** Navmesh sample of a cell in one height band */
+	struct FNavCell
+	{
+		FVector NavLocation = FVector::ZeroVector;
+		bool bWalkable = false;
+
+		/** Bits of the ExpandOffsets already raycast from this cell, and the ones the navmesh connects */
+		uint8 CheckedEdges = 0;
+		uint8 OpenEdges = 0;
+	};
+
+	/** Cache key of the cell in the height band of Height */
+	FIntVector GetNavCellKey(const FIntPoint& Cell, float Height) const;
+
+	/** Navmesh sample of the cell around Height, projected once per cell and height band */
+	FNavCell& GetNavCell(const FIntPoint& Cell, float Height);
+
+	/** The navmesh leads from the cell to its neighbour at ExpandOffsets[OffsetIndex], raycast once per edge */
+	bool IsConnected(const FIntPoint& Cell, int32 OffsetIndex, float Height);
+
+	void StartBuild(const FIntPoint& GoalCell, float GoalHeight);
+
+	/**
+	 * Move the goal of the active field to a nearby cell. Distances are recomputed in the window around the new goal
+	 * and the rest of the field is raised so it still descends into the window.
+	 * False when the old goal is out of the window or not reachable inside it, the field then needs a build
+	 */
+	bool RepairField(const FIntPoint& GoalCell);
+
+	/** Expand the field under construction by up to CellsPerFrame cells */
+	void ContinueBuild();
+
+	/** Size of a field cell */
+	float CellSize;
+
+	/** Cells from the goal to the field border */
+	int32 FieldRadius;
+
+	/** Cells expanded per frame while building */
+	int32 CellsPerFrame;
+
+	/** Cells from the new goal to the border of the repaired window */
+	int32 RepairRadius;
+
+	/** Sampled cells kept before the ones far from a new build are dropped */
+	int32 MaxNavCells;
+
+	/** Height searched for the navmesh above and below a cell, also the size of the cache height bands */
+	float NavProjectionHeight;
+
+	/** Seconds the field keeps building after the last failed follow request */
+	float DemandTimeout;
+
+	float LastDemandTime;
+
+	/** Actor the fields lead to */
+	TWeakObjectPtr<AActor> Goal;
+
+	/** Distance to the goal of every cell of the active field, row by row */
+	TArray<uint16> FieldDistances;
+
+	/** First cell of the active field */
+	FIntPoint FieldOrigin;
+
+	/** Goal cell of the active field */
+	FIntPoint FieldGoalCell;
+
+	/** Goal height of the active field, a new height band rebuilds it */
+	float FieldHeight;
+
+	/** Largest distance of the active field, repairs raise it */
+	int32 FieldMaxDistance;
+
+	bool bHasField;
+
+	/** Field under construction */
+	TArray<uint16> BuildDistances;
+	TArray<int32> BuildFrontier;
+	int32 BuildFrontierHead;
+	FIntPoint BuildOrigin;
+	FIntPoint BuildGoalCell;
+	float BuildHeight;
+	int32 BuildMaxDistance;
+	bool bBuilding;
+
+	/** Window of a repair, kept to reuse the allocations */
+	TArray<uint16> RepairDistances;
+	TArray<int32> RepairFrontier;
+
+	/** Cells sampled so far by height band, the navmesh does not change at runtime. Bounded by MaxNavCells */
+	TMap<FIntVector, FNavCell> NavCells;
+
+	TArray<TWeakObjectPtr<APawn>> Followers;
+};
@@ -4,18 +4,41 @@
 #include "GruxAnimInstance.h"
 
 #include "Enemy.h"
+#include "ThreadSafeAnimInstanceProxy.h"
 
 void UGruxAnimInstance::UpdateAnimationProperties(float DeltaTime)
+{
+}
+
+void UGruxAnimInstance::SnapshotGameThreadState(float DeltaTime)
 {
 	if (Enemy == nullptr)
 	{
 		Enemy = Cast<AEnemy>(TryGetPawnOwner());
 	}
 
+	Snapshot.bValid = Enemy != nullptr;
 	if (Enemy)
 	{
-		FVector Velocity{Enemy->GetVelocity()};
-		Velocity.Z = 0.f;
-		Speed = Velocity.Size();
+		Snapshot.Velocity = Enemy->GetVelocity();
 	}
 }
+
+void UGruxAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaTime)
+{
+	if (!Snapshot.bValid) return;
+
+	FVector Velocity{Snapshot.Velocity};
+	Velocity.Z = 0.f;
+	Speed = Velocity.Size();
+}
+
+FAnimInstanceProxy* UGruxAnimInstance::CreateAnimInstanceProxy()
+{
+	return new TThreadSafeAnimInstanceProxy<UGruxAnimInstance>(this);
+}
+
+void UGruxAnimInstance::DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy)
+{
+	delete InProxy;
+}
@@ -6,6 +6,14 @@
 #include "Animation/AnimInstance.h"
 #include "GruxAnimInstance.generated.h"
 
+/** Owner state copied on the game thread for the worker thread update */
+struct FGruxAnimSnapshot
+{
+	FVector Velocity = FVector::ZeroVector;
+
+	bool bValid = false;
+};
+
 /**
  * 
  */
@@ -15,9 +23,21 @@ class SHOOTER_API UGruxAnimInstance : public UAnimInstance
 	GENERATED_BODY()
 
 public:
+	/** Kept for the animation blueprint, the properties are now updated natively on the animation worker */
 	UFUNCTION(BlueprintCallable)
 	void UpdateAnimationProperties(float DeltaTime);
 
+	/** Copy the enemy state, game thread */
+	void SnapshotGameThreadState(float DeltaTime);
+
+	/** Derive the animation properties from the snapshot, any thread */
+	void NativeThreadSafeUpdateAnimation(float DeltaTime);
+
+protected:
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override;
+
+	virtual void DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy) override;
+
 private:
 	/** Lateral movement Speed */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Movement", meta=(AllowPrivateAccess="true"))
@@ -26,4 +46,6 @@ private:
 	/** Lateral movement Speed */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta=(AllowPrivateAccess="true"))
 	class AEnemy* Enemy;
+
+	FGruxAnimSnapshot Snapshot;
 };
@@ -0,0 +1,131 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HitNumberSubsystem.h"
+
+#include "SceneView.h"
+#include "Shooter.h"
+#include "Blueprint/UserWidget.h"
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Hit Numbers"), STAT_ActiveHitNumbers, STATGROUP_Shooter);
+DECLARE_CYCLE_STAT(TEXT("Hit Numbers Tick"), STAT_HitNumbersTick, STATGROUP_Shooter);
+
+void UHitNumberSubsystem::Deinitialize()
+{
+	ActiveHitNumbers.Empty();
+	Pools.Empty();
+
+	Super::Deinitialize();
+}
+
+UUserWidget* UHitNumberSubsystem::AcquireHitNumber(TSubclassOf<UUserWidget> HitNumberClass)
+{
+	if (HitNumberClass == nullptr) return nullptr;
+
+	FHitNumberPool& Pool = Pools.FindOrAdd(HitNumberClass);
+	while (Pool.Widgets.Num() > 0)
+	{
+		UUserWidget* HitNumber = Pool.Widgets.Pop(false);
+		if (HitNumber)
+		{
+			return HitNumber;
+		}
+	}
+
+	return CreateWidget<UUserWidget>(GetWorld()->GetFirstPlayerController(), HitNumberClass);
+}
+
+void UHitNumberSubsystem::AddHitNumber(UUserWidget* HitNumber, const FVector& Location, float Duration)
+{
+	if (HitNumber == nullptr) return;
+
+	if (!HitNumber->IsInViewport())
+	{
+		HitNumber->AddToViewport();
+	}
+
+	FActiveHitNumber& ActiveHitNumber = ActiveHitNumbers.AddDefaulted_GetRef();
+	ActiveHitNumber.Widget = HitNumber;
+	ActiveHitNumber.Location = Location;
+	ActiveHitNumber.ExpireTime = GetWorld()->GetTimeSeconds() + Duration;
+}
+
+void UHitNumberSubsystem::ReleaseHitNumber(UUserWidget* HitNumber)
+{
+	if (HitNumber == nullptr) return;
+
+	HitNumber->RemoveFromParent();
+
+	// Widgets created outside the pool would otherwise pile up in it
+	FHitNumberPool& Pool = Pools.FindOrAdd(HitNumber->GetClass());
+	if (Pool.Widgets.Num() < MaxPooledHitNumbers)
+	{
+		Pool.Widgets.Add(HitNumber);
+	}
+}
+
+void UHitNumberSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_HitNumbersTick);
+
+	ExpireHitNumbers();
+	UpdateHitNumberPositions();
+
+	INC_DWORD_STAT_BY(STAT_ActiveHitNumbers, ActiveHitNumbers.Num());
+}
+
+void UHitNumberSubsystem::ExpireHitNumbers()
+{
+	const float TimeSeconds{GetWorld()->GetTimeSeconds()};
+	for (int32 Index = ActiveHitNumbers.Num() - 1; Index >= 0; --Index)
+	{
+		if (ActiveHitNumbers[Index].ExpireTime <= TimeSeconds || ActiveHitNumbers[Index].Widget == nullptr)
+		{
+			ReleaseHitNumber(ActiveHitNumbers[Index].Widget);
+			ActiveHitNumbers.RemoveAtSwap(Index, 1, false);
+		}
+	}
+}
+
+void UHitNumberSubsystem::UpdateHitNumberPositions()
+{
+	if (ActiveHitNumbers.Num() == 0) return;
+
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	ULocalPlayer* const LocalPlayer = PlayerController ? PlayerController->GetLocalPlayer() : nullptr;
+	if (LocalPlayer == nullptr || LocalPlayer->ViewportClient == nullptr) return;
+
+	// Same projection as UGameplayStatics::ProjectWorldToScreen, computed once for all the widgets
+	FSceneViewProjectionData ProjectionData;
+	if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, eSSP_FULL, ProjectionData)) return;
+
+	const FMatrix ViewProjectionMatrix{ProjectionData.ComputeViewProjectionMatrix()};
+	const FIntRect ViewRect{ProjectionData.GetConstrainedViewRect()};
+
+	for (const FActiveHitNumber& ActiveHitNumber : ActiveHitNumbers)
+	{
+		FVector2D ScreenPosition;
+		if (FSceneView::ProjectWorldToScreen(ActiveHitNumber.Location, ViewRect, ViewProjectionMatrix, ScreenPosition))
+		{
+			ActiveHitNumber.Widget->SetPositionInViewport(ScreenPosition);
+		}
+	}
+}
+
+ETickableTickType UHitNumberSubsystem::GetTickableTickType() const
+{
+	// The class default object never ticks
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UHitNumberSubsystem::IsTickable() const
+{
+	return ActiveHitNumbers.Num() > 0;
+}
+
+TStatId UHitNumberSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UHitNumberSubsystem, STATGROUP_Tickables);
+}
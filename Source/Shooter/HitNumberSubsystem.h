@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "HitNumberSubsystem.generated.h"
+
+class UUserWidget;
+
+/** A hit number widget currently on screen */
+USTRUCT()
+struct FActiveHitNumber
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UUserWidget* Widget = nullptr;
+
+	/* World location the widget follows */
+	FVector Location = FVector::ZeroVector;
+
+	/* World time at which the widget goes back to the pool */
+	float ExpireTime = 0.f;
+};
+
+/** Hidden hit number widgets of one widget class, ready to be reused */
+USTRUCT()
+struct FHitNumberPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<UUserWidget*> Widgets;
+};
+
+/**
+ * Owns every hit number widget of the world, recycles them and
+ * projects all the active ones to the screen in a single pass per frame
+ */
+UCLASS()
+class SHOOTER_API UHitNumberSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Pooled widget of the given class, created when the pool is empty */
+	UUserWidget* AcquireHitNumber(TSubclassOf<UUserWidget> HitNumberClass);
+
+	/** Show the widget at the world location until Duration seconds have passed */
+	void AddHitNumber(UUserWidget* HitNumber, const FVector& Location, float Duration);
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+private:
+	/** Remove the widget from the screen and put it back in its pool */
+	void ReleaseHitNumber(UUserWidget* HitNumber);
+
+	/** Return expired widgets to the pool */
+	void ExpireHitNumbers();
+
+	/** Project every active widget with one view projection matrix */
+	void UpdateHitNumberPositions();
+
+	UPROPERTY()
+	TArray<FActiveHitNumber> ActiveHitNumbers;
+
+	UPROPERTY()
+	TMap<UClass*, FHitNumberPool> Pools;
+
+	/** Idle widgets kept per class, widgets released past it are left to the garbage collector */
+	int32 MaxPooledHitNumbers = 32;
+};
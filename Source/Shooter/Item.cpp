@@ -3,6 +3,9 @@
 
 #include "Item.h"
 
+#include "ItemRegistrySubsystem.h"
+#include "Shooter.h"
+#include "ShooterDataSubsystem.h"
 #include "ShooterCharacter.h"
 #include "Camera/CameraComponent.h"
 #include "Components/BoxComponent.h"
@@ -13,6 +16,8 @@
 #include "Kismet/KismetMathLibrary.h"
 #include "Sound/SoundCue.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ticking Items"), STAT_TickingItems, STATGROUP_Shooter);
+
 // Sets default values
 AItem::AItem():
 #pragma region Variable Initialization
@@ -39,6 +44,7 @@ AItem::AItem():
 	FresnelExponent(3.f),
 	FresnelReflectFraction(4.f),
 	PulseCurveTime(5.f),
+	ViewCheckInterval(0.25f),
 	SlotIndex(0),
 	bCharacterInventoryFull(false)
 
@@ -46,8 +52,9 @@ AItem::AItem():
 
 
 {
-	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+	// Tick is only turned on while the item has work, see UpdateTickEnabled
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	// Create ItemSkeletalMesh and Set it as root component 
 	ItemSkeletalMesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("ItemSkeletalMesh"));
@@ -99,7 +106,23 @@ void AItem::BeginPlay()
 	//Set Custom Depth to disabled 
 	InitializeCustomDepth();
 
+	ApplyPulseMode();
+
 	StartPulseTimer();
+
+	UpdateItemRegistry();
+
+	UpdateTickEnabled();
+}
+
+void AItem::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UItemRegistrySubsystem* ItemRegistry = GetWorld()->GetSubsystem<UItemRegistrySubsystem>())
+	{
+		ItemRegistry->UnregisterItem(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // Function to trigger on Begin overlap with AreaSphere
@@ -182,130 +205,88 @@ void AItem::SetActiveStars()
 	}
 }
 
-// Set Item Properties Based on Item State 
-void AItem::SetItemProperties(EItemState State)
+namespace
 {
-	// Switch on state
-	switch (State)
-	{
-	case EItemState::EIS_PickUp:
+	const FName ItemNoCollisionProfile{TEXT("ItemNoCollision")};
+	const FName ItemTraceBoxProfile{TEXT("ItemTraceBox")};
+	const FName ItemAreaSphereProfile{TEXT("ItemAreaSphere")};
+	const FName ItemFallingProfile{TEXT("ItemFalling")};
+
+	/** Component setup for every EItemState, the last entry is used for EIS_Max */
+	const FItemStateProfile ItemStateProfiles[] = {
+		// EIS_PickUp
+		{ItemNoCollisionProfile, ItemAreaSphereProfile, ItemTraceBoxProfile, false, true, false},
+		// EIS_EquipInterping
+		{ItemNoCollisionProfile, ItemNoCollisionProfile, ItemNoCollisionProfile, false, true, true},
+		// EIS_PickedUp
+		{ItemNoCollisionProfile, ItemNoCollisionProfile, ItemNoCollisionProfile, false, false, true},
+		// EIS_Equipped
+		{ItemNoCollisionProfile, ItemNoCollisionProfile, ItemNoCollisionProfile, false, true, true},
+		// EIS_Falling
+		{ItemFallingProfile, ItemNoCollisionProfile, ItemNoCollisionProfile, true, true, false},
+		// EIS_Max, same as a pickup
+		{ItemNoCollisionProfile, ItemAreaSphereProfile, ItemTraceBoxProfile, false, true, false},
+	};
+
+	static_assert(UE_ARRAY_COUNT(ItemStateProfiles) == static_cast<uint8>(EItemState::EIS_Max) + 1,
+		"Every item state needs a profile");
+}
 
-		// If A PickUp
-		/* Set SkeletalMesh properties: */
-		ItemSkeletalMesh->SetSimulatePhysics(false);
-		ItemSkeletalMesh->SetEnableGravity(false);
-		ItemSkeletalMesh->SetVisibility(true);
-		ItemSkeletalMesh->SetCollisionResponseToAllChannels(ECR_Ignore);
-		ItemSkeletalMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+const FItemStateProfile& AItem::GetItemStateProfile(EItemState State)
+{
+	return ItemStateProfiles[FMath::Min(static_cast<uint8>(State), static_cast<uint8>(EItemState::EIS_Max))];
+}
 
-		/* Set AreaSphere properties: */
-		AreaSphere->SetCollisionResponseToAllChannels(ECR_Overlap);
-		AreaSphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+void AItem::SetCollisionProfileIfChanged(UPrimitiveComponent* Component, FName ProfileName)
+{
+	if (Component->GetCollisionProfileName() != ProfileName)
+	{
+		Component->SetCollisionProfileName(ProfileName);
+	}
+}
 
-		/*Set Collision Box properties */
-		CollisionBox->SetCollisionResponseToAllChannels(ECR_Ignore);
-		CollisionBox->SetCollisionResponseToChannel(ECC_Visibility, ECR_Block);
-		CollisionBox->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-		break;
-	case EItemState::EIS_Equipped:
-		PickUpWidget->SetVisibility(false);
-		// If Equipped
-		/* Set SkeletalMesh Properties*/
-		ItemSkeletalMesh->SetSimulatePhysics(false);
-		ItemSkeletalMesh->SetEnableGravity(false);
-		ItemSkeletalMesh->SetVisibility(true);
-		ItemSkeletalMesh->SetCollisionResponseToAllChannels(ECR_Ignore);
-		ItemSkeletalMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-
-		//Set AreaSphere properties 
-		AreaSphere->SetCollisionResponseToAllChannels(ECR_Ignore);
-		AreaSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-
-		//Set Collision Box properties
-		CollisionBox->SetCollisionResponseToAllChannels(ECR_Ignore);
-		CollisionBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		break;
-	case EItemState::EIS_Falling:
-		// Set Mesh Properties
-		ItemSkeletalMesh->SetSimulatePhysics(true);
-		ItemSkeletalMesh->SetEnableGravity(true);
-		ItemSkeletalMesh->SetVisibility(true);
-		ItemSkeletalMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-		ItemSkeletalMesh->SetCollisionResponseToAllChannels(ECR_Ignore);
-		ItemSkeletalMesh->SetCollisionResponseToChannel(ECC_WorldStatic, ECR_Block);
-
-		//Set AreaSphere properties 
-		AreaSphere->SetCollisionResponseToAllChannels(ECR_Ignore);
-		AreaSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-
-		//Set Collision Box properties
-		CollisionBox->SetCollisionResponseToAllChannels(ECR_Ignore);
-		CollisionBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		break;
-	case EItemState::EIS_EquipInterping:
-		PickUpWidget->SetVisibility(false);
-		// If Equipped
-		/* Set SkeletalMesh Properties*/
-		ItemSkeletalMesh->SetSimulatePhysics(false);
-		ItemSkeletalMesh->SetEnableGravity(false);
-		ItemSkeletalMesh->SetVisibility(true);
-		ItemSkeletalMesh->SetCollisionResponseToAllChannels(ECR_Ignore);
-		ItemSkeletalMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-
-		//Set AreaSphere properties 
-		AreaSphere->SetCollisionResponseToAllChannels(ECR_Ignore);
-		AreaSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-
-		//Set Collision Box properties
-		CollisionBox->SetCollisionResponseToAllChannels(ECR_Ignore);
-		CollisionBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		break;
+void AItem::ApplyMeshStateProfile(UPrimitiveComponent* Mesh, const FItemStateProfile& Profile, bool bVisible)
+{
+	// Stop simulating before the collision goes away, start once the collision is there
+	if (!Profile.bSimulatePhysics && Mesh->IsSimulatingPhysics())
+	{
+		Mesh->SetSimulatePhysics(false);
+	}
+	SetCollisionProfileIfChanged(Mesh, Profile.MeshProfile);
+	if (Mesh->IsGravityEnabled() != Profile.bSimulatePhysics)
+	{
+		Mesh->SetEnableGravity(Profile.bSimulatePhysics);
+	}
+	if (Profile.bSimulatePhysics && !Mesh->IsSimulatingPhysics())
+	{
+		Mesh->SetSimulatePhysics(true);
+	}
 
-	case EItemState::EIS_PickedUp:
-		PickUpWidget->SetVisibility(false);
-		// If Equipped
-		/* Set SkeletalMesh Properties*/
-		ItemSkeletalMesh->SetSimulatePhysics(false);
-		ItemSkeletalMesh->SetEnableGravity(false);
-		ItemSkeletalMesh->SetVisibility(false);
-		ItemSkeletalMesh->SetCollisionResponseToAllChannels(ECR_Ignore);
-		ItemSkeletalMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-
-		//Set AreaSphere properties 
-		AreaSphere->SetCollisionResponseToAllChannels(ECR_Ignore);
-		AreaSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-
-		//Set Collision Box properties
-		CollisionBox->SetCollisionResponseToAllChannels(ECR_Ignore);
-		CollisionBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		break;
-		/* TODO : Finish All Cases */
+	if (Mesh->IsVisible() != bVisible)
+	{
+		Mesh->SetVisibility(bVisible);
+	}
+}
 
-		/* FIXME Add Cases Here please */
+// Set Item Properties Based on Item State 
+void AItem::SetItemProperties(EItemState State)
+{
+	const FItemStateProfile& Profile = GetItemStateProfile(State);
 
-	default:
-		// If A PickUp
-		/* Set SkeletalMesh properties: */
-		ItemSkeletalMesh->SetSimulatePhysics(false);
-		ItemSkeletalMesh->SetVisibility(true);
-		ItemSkeletalMesh->SetCollisionResponseToAllChannels(ECR_Ignore);
-		ItemSkeletalMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-
-		/* Set AreaSphere properties: */
-		AreaSphere->SetCollisionResponseToAllChannels(ECR_Overlap);
-		AreaSphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-
-		/*Set Collision Box properties */
-		CollisionBox->SetCollisionResponseToAllChannels(ECR_Ignore);
-		CollisionBox->SetCollisionResponseToChannel(ECC_Visibility, ECR_Block);
-		CollisionBox->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-		break;
+	if (Profile.bHidePickUpWidget)
+	{
+		PickUpWidget->SetVisibility(false);
 	}
+
+	ApplyMeshStateProfile(ItemSkeletalMesh, Profile, Profile.bMeshVisible);
+	SetCollisionProfileIfChanged(AreaSphere, Profile.AreaSphereProfile);
+	SetCollisionProfileIfChanged(CollisionBox, Profile.CollisionBoxProfile);
 }
 
 void AItem::FinishInterping()
 {
 	bInterping = false;
+	UpdateTickEnabled();
 	if (Character)
 	{
 		//Subtract  1 from the item count of the interpLocation struct 
@@ -407,7 +388,7 @@ void AItem::PlayPickUpSound(bool bForcePlaySound)
 		}
 		else if (Character->ShouldPlayPickUpSound())
 		{
-			Character->StartPickUpSoundTimer();
+			Character->StartPickUpSoundCooldown();
 			if (PickUpSound)
 			{
 				UGameplayStatics::PlaySound2D(this, PickUpSound);
@@ -440,50 +421,19 @@ void AItem::InitializeCustomDepth()
 void AItem::OnConstruction(const FTransform& Transform)
 {
 	Super::OnConstruction(Transform);
-	// Load the data in the item rarity data table
-
-	//Path to the item rarity datatable 
-	const FString RarityTablePath(TEXT("DataTable'/Game/_Game/DataTables/ItemRarityDataTable.ItemRarityDataTable'"));
+	// Get the item rarity row from the cached data tables
+	const FItemRarityTable* RarityRow = UShooterDataSubsystem::GetRarityDefinition(this, ItemRarity);
 
-	UDataTable* RarityTableObject = Cast<UDataTable>(
-		StaticLoadObject(UDataTable::StaticClass(), nullptr, *RarityTablePath));
-
-	if (RarityTableObject)
+	if (RarityRow)
 	{
-		FItemRarityTable* RarityRow = nullptr;
-		switch (ItemRarity)
+		GlowColor = RarityRow->GlowColor;
+		LightColor = RarityRow->LightColor;
+		DarkColor = RarityRow->DarkColor;
+		NumberOfStars = RarityRow->NumberOfStars;
+		IconBackground = RarityRow->IconBackground;
+		if (GetItemSkeletalMesh())
 		{
-		case EItemRarity::EIR_Damaged:
-			RarityRow = RarityTableObject->FindRow<FItemRarityTable>(FName("Damaged"),TEXT(""));
-			break;
-		case EItemRarity::EIR_Common:
-			RarityRow = RarityTableObject->FindRow<FItemRarityTable>(FName("Common"),TEXT(""));
-			break;
-		case EItemRarity::EIR_Uncommon:
-			RarityRow = RarityTableObject->FindRow<FItemRarityTable>(FName("UnCommon"),TEXT(""));
-			break;
-		case EItemRarity::EIR_Rare:
-			RarityRow = RarityTableObject->FindRow<FItemRarityTable>(FName("Rare"),TEXT(""));
-			break;
-		case EItemRarity::EIR_Legendary:
-			RarityRow = RarityTableObject->FindRow<FItemRarityTable>(FName("Legendary"),TEXT(""));
-			break;
-		default:
-			RarityRow = nullptr;
-			break;
-		}
-
-		if (RarityRow)
-		{
-			GlowColor = RarityRow->GlowColor;
-			LightColor = RarityRow->LightColor;
-			DarkColor = RarityRow->DarkColor;
-			NumberOfStars = RarityRow->NumberOfStars;
-			IconBackground = RarityRow->IconBackground;
-			if (GetItemSkeletalMesh())
-			{
-				GetItemSkeletalMesh()->SetCustomDepthStencilValue(RarityRow->CustomDepthStencil);
-			}
+			GetItemSkeletalMesh()->SetCustomDepthStencilValue(RarityRow->CustomDepthStencil);
 		}
 	}
 	if (MaterialInstance)
@@ -510,23 +460,50 @@ void AItem::UpdatePulse()
 	switch (ItemState)
 	{
 	case EItemState::EIS_PickUp:
+		// The shared pulse drives the material, nothing to write
+		if (PulseCurve == nullptr || UsesSharedPulse()) return;
 
-		if (PulseCurve)
-		{
-			ElapsedTime = GetWorldTimerManager().GetTimerElapsed(PulseTimer);
-			CurveValue = PulseCurve->GetVectorValue(ElapsedTime);
-		}
+		ElapsedTime = GetWorldTimerManager().GetTimerElapsed(PulseTimer);
+		CurveValue = PulseCurve->GetVectorValue(ElapsedTime);
 		break;
 	case EItemState::EIS_EquipInterping:
-		if (InterpPulseCurve)
-		{
-			ElapsedTime = GetWorldTimerManager().GetTimerElapsed(ItemInterpTimer);
-			CurveValue = InterpPulseCurve->GetVectorValue(ElapsedTime);
-		}
+		if (InterpPulseCurve == nullptr) return;
+
+		ElapsedTime = GetWorldTimerManager().GetTimerElapsed(ItemInterpTimer);
+		CurveValue = InterpPulseCurve->GetVectorValue(ElapsedTime);
 		break;
 	default:
-		break;
+		return;
 	}
+	SetPulseParameters(CurveValue);
+}
+
+void AItem::ApplyPulseMode()
+{
+	if (DynamicMaterialInstance == nullptr) return;
+
+	// PickUp items read their pulse from the shared material parameter collection when there is one
+	const bool bSharedPulse{ItemState == EItemState::EIS_PickUp && UsesSharedPulse()};
+	DynamicMaterialInstance->SetScalarParameterValue(TEXT("SharedPulse"), bSharedPulse ? 1.f : 0.f);
+
+	// States without a pulse keep the params at zero, the others update them every tick
+	const bool bOwnPulse{
+		ItemState == EItemState::EIS_EquipInterping || (ItemState == EItemState::EIS_PickUp && !bSharedPulse)
+	};
+	if (!bOwnPulse)
+	{
+		SetPulseParameters(FVector::ZeroVector);
+	}
+}
+
+bool AItem::UsesSharedPulse() const
+{
+	const UItemRegistrySubsystem* ItemRegistry = GetWorld()->GetSubsystem<UItemRegistrySubsystem>();
+	return ItemRegistry && ItemRegistry->HasSharedPulse();
+}
+
+void AItem::SetPulseParameters(const FVector& CurveValue)
+{
 	if (DynamicMaterialInstance)
 	{
 		DynamicMaterialInstance->SetScalarParameterValue(TEXT("GlowAmount"), CurveValue.X * GlowAmount);
@@ -557,7 +534,7 @@ void AItem::PlayEquipSound(bool bForcePlaySound)
 		}
 		else if (Character->ShouldPlayEquipSound())
 		{
-			Character->StartEquipSoundTimer();
+			Character->StartEquipSoundCooldown();
 			if (EquipSound)
 			{
 				UGameplayStatics::PlaySound2D(this, EquipSound);
@@ -571,11 +548,34 @@ void AItem::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	INC_DWORD_STAT(STAT_TickingItems);
+
 	//Handle item interp when in the equip interping state 
 	ItemInterp(DeltaTime);
 
-	//Get Curve values from PulseCurve and set dynamic material params
+	//Get Curve values from PulseCurve or InterpPulseCurve and set dynamic material params
 	UpdatePulse();
+
+	// Stop ticking once the work is done, e.g. the item went out of view
+	UpdateTickEnabled();
+}
+
+bool AItem::HasTickWork() const
+{
+	if (bInterping) return true;
+
+	// Without the shared pulse, only pulse pickups that were rendered recently
+	return ItemState == EItemState::EIS_PickUp && PulseCurve && DynamicMaterialInstance && !UsesSharedPulse() &&
+		WasRecentlyRendered(ViewCheckInterval);
+}
+
+void AItem::UpdateTickEnabled()
+{
+	const bool bShouldTick{HasTickWork()};
+	if (IsActorTickEnabled() != bShouldTick)
+	{
+		SetActorTickEnabled(bShouldTick);
+	}
 }
 
 void AItem::ResetPulseTimer()
@@ -585,7 +585,7 @@ void AItem::ResetPulseTimer()
 
 void AItem::StartPulseTimer()
 {
-	if (ItemState == EItemState::EIS_PickUp)
+	if (ItemState == EItemState::EIS_PickUp && !UsesSharedPulse())
 	{
 		GetWorldTimerManager().SetTimer(PulseTimer, this, &AItem::ResetPulseTimer, PulseCurveTime);
 	}
@@ -598,6 +598,24 @@ void AItem::SetItemState(EItemState State)
 	ItemState = State;
 	// Setting the properties based on the new State
 	SetItemProperties(State);
+	ApplyPulseMode();
+	UpdateItemRegistry();
+	UpdateTickEnabled();
+}
+
+void AItem::UpdateItemRegistry()
+{
+	UItemRegistrySubsystem* ItemRegistry = GetWorld()->GetSubsystem<UItemRegistrySubsystem>();
+	if (ItemRegistry == nullptr) return;
+
+	if (ItemState == EItemState::EIS_PickUp)
+	{
+		ItemRegistry->RegisterItem(this);
+	}
+	else
+	{
+		ItemRegistry->UnregisterItem(this);
+	}
 }
 
 void AItem::StartItemCurve(AShooterCharacter* Char, bool bForcePlaySound)
@@ -631,3 +649,97 @@ void AItem::StartItemCurve(AShooterCharacter* Char, bool bForcePlaySound)
 
 	bCanChangeCustomDepth = false;
 }
+
+#if !UE_BUILD_SHIPPING
+namespace
+{
+	// The per channel calls the old SetItemProperties made for the PickUp and PickedUp states
+	void ApplyBaselineItemProperties(const AItem* Item, EItemState State)
+	{
+		const bool bPickUp{State == EItemState::EIS_PickUp};
+		if (!bPickUp)
+		{
+			Item->GetPickUpWidget()->SetVisibility(false);
+		}
+
+		USkeletalMeshComponent* Mesh = Item->GetItemSkeletalMesh();
+		Mesh->SetSimulatePhysics(false);
+		Mesh->SetEnableGravity(false);
+		Mesh->SetVisibility(bPickUp);
+		Mesh->SetCollisionResponseToAllChannels(ECR_Ignore);
+		Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+		USphereComponent* AreaSphere = Item->GetAreaSphere();
+		AreaSphere->SetCollisionResponseToAllChannels(bPickUp ? ECR_Overlap : ECR_Ignore);
+		AreaSphere->SetCollisionEnabled(bPickUp ? ECollisionEnabled::QueryOnly : ECollisionEnabled::NoCollision);
+
+		UBoxComponent* CollisionBox = Item->GetCollisionBox();
+		CollisionBox->SetCollisionResponseToAllChannels(ECR_Ignore);
+		if (bPickUp)
+		{
+			CollisionBox->SetCollisionResponseToChannel(ECC_Visibility, ECR_Block);
+		}
+		CollisionBox->SetCollisionEnabled(bPickUp ? ECollisionEnabled::QueryAndPhysics : ECollisionEnabled::NoCollision);
+	}
+
+	// Times item state changes with the old per channel calls and with the state profiles on freshly spawned items,
+	// then the same state again to show the unchanged skip
+	void BenchItemStates(const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 Count{Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 500};
+		if (World == nullptr || Count <= 0) return;
+
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		TArray<AItem*> Items;
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			AItem* Item = World->SpawnActor<AItem>(AItem::StaticClass(), FVector(0.f, 0.f, -100000.f - Index * 100.f),
+			                                       FRotator::ZeroRotator, SpawnParameters);
+			if (Item)
+			{
+				Items.Add(Item);
+			}
+		}
+
+		const double BaselineStart{FPlatformTime::Seconds()};
+		for (const AItem* Item : Items)
+		{
+			ApplyBaselineItemProperties(Item, EItemState::EIS_PickedUp);
+			ApplyBaselineItemProperties(Item, EItemState::EIS_PickUp);
+		}
+		const double BaselineTime{FPlatformTime::Seconds() - BaselineStart};
+
+		const double ChangeStart{FPlatformTime::Seconds()};
+		for (AItem* Item : Items)
+		{
+			Item->SetItemState(EItemState::EIS_PickedUp);
+			Item->SetItemState(EItemState::EIS_PickUp);
+		}
+		const double ChangeTime{FPlatformTime::Seconds() - ChangeStart};
+
+		const double SameStart{FPlatformTime::Seconds()};
+		for (AItem* Item : Items)
+		{
+			Item->SetItemState(EItemState::EIS_PickUp);
+			Item->SetItemState(EItemState::EIS_PickUp);
+		}
+		const double SameTime{FPlatformTime::Seconds() - SameStart};
+
+		UE_LOG(LogTemp, Log,
+		       TEXT("BenchItemStates: %d items, PickUp/PickedUp changes per channel %.3f ms, state profiles %.3f ms, unchanged state %.3f ms"),
+		       Items.Num(), BaselineTime * 1000.0, ChangeTime * 1000.0, SameTime * 1000.0);
+
+		for (AItem* Item : Items)
+		{
+			Item->Destroy();
+		}
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs BenchItemStatesCommand(
+		TEXT("Shooter.BenchItemStates"),
+		TEXT("Compare item state changes through per channel calls and the state profiles. Usage: Shooter.BenchItemStates [Count]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BenchItemStates));
+}
+#endif
@@ -66,6 +66,17 @@ enum class EItemType:uint8
 };
 #pragma endregion
 
+/* Collision profiles, physics and visibility of the item components in one item state */
+struct FItemStateProfile
+{
+	FName MeshProfile;
+	FName AreaSphereProfile;
+	FName CollisionBoxProfile;
+	bool bSimulatePhysics;
+	bool bMeshVisible;
+	bool bHidePickUpWidget;
+};
+
 UCLASS()
 class SHOOTER_API AItem : public AActor
 {
@@ -80,6 +91,8 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	// Called When Overlapping Area sphere 
 	UFUNCTION()
 	void OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp,
@@ -98,6 +111,15 @@ protected:
 	/** Set Properties of the items component based on state */
 	virtual void SetItemProperties(EItemState State);
 
+	/** Profile of the item components for the state */
+	static const FItemStateProfile& GetItemStateProfile(EItemState State);
+
+	/** Apply the mesh part of a state profile, components already matching it are left alone */
+	static void ApplyMeshStateProfile(UPrimitiveComponent* Mesh, const FItemStateProfile& Profile, bool bVisible);
+
+	/** Switch the component to the collision profile unless it already uses it */
+	static void SetCollisionProfileIfChanged(UPrimitiveComponent* Component, FName ProfileName);
+
 	/** Called when Item interp timer is finished  */
 	void FinishInterping();
 
@@ -116,18 +138,37 @@ protected:
 
 	void EnableGlowMaterial();
 
+	/** Drive the glow params from InterpPulseCurve while interping, or from PulseCurve without the shared pulse */
 	void UpdatePulse();
 
 	void ResetPulseTimer();
 
 	void StartPulseTimer();
 
+	/** True when idle pickups read their pulse from the item registry's material parameter collection */
+	bool UsesSharedPulse() const;
+
+	/** Switch the material between the shared pickup pulse and the per item params for the current state */
+	void ApplyPulseMode();
+
+	/** Write the glow and fresnel params of the dynamic material, scaled by their amounts */
+	void SetPulseParameters(const FVector& CurveValue);
+
+	/** Keep the item registry in sync with the item state, only PickUp items are registered */
+	void UpdateItemRegistry();
+
+	/** True while the item has per frame work: interping, or pulsing in view without the shared pulse */
+	virtual bool HasTickWork() const;
+
 #pragma  endregion
 
 public:
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
 
+	/** Turn the actor tick on or off to match HasTickWork, the item registry calls it to catch pickups coming into view */
+	void UpdateTickEnabled();
+
 private:
 	// Item Components 
 #pragma region Item Components
@@ -235,13 +276,17 @@ private:
 
 	bool bCanChangeCustomDepth;
 
-	//  Curve to drive the dynamic material params  
+	//  Curve to drive the dynamic material params of an idle pickup when there is no shared pulse  
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Item Properties", meta=(AllowPrivateAccess="true"))
 	class UCurveVector* PulseCurve;
 
 
 	FTimerHandle PulseTimer;
 
+	/** Seconds without being rendered before an idle pickup stops ticking its pulse */
+	UPROPERTY(EditDefaultsOnly, Category="Item Properties", meta=(AllowPrivateAccess="true"))
+	float ViewCheckInterval;
+
 	//  Time for the pulse timer
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Item Properties", meta=(AllowPrivateAccess="true"))
 	float PulseCurveTime;
@@ -258,7 +303,7 @@ private:
 	UPROPERTY(VisibleAnywhere, Category="Item Properties", meta=(AllowPrivateAccess="true"))
 	float FresnelReflectFraction;
 
-	//  Curve to drive the dynamic material params  
+	//  Curve to drive the dynamic material params while interping, idle pickups use the shared pulse  
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Item Properties", meta=(AllowPrivateAccess="true"))
 	UCurveVector* InterpPulseCurve;
 
@@ -324,6 +369,8 @@ public:
 
 	FORCEINLINE int32 GetItemCount() const { return ItemCount; }
 
+	FORCEINLINE EItemRarity GetItemRarity() const { return ItemRarity; }
+
 	FORCEINLINE int32 GetSlotIndex() const { return SlotIndex; }
 
 	FORCEINLINE UMaterialInstance* GetMaterialInstance() const { return MaterialInstance; }
@@ -342,6 +389,10 @@ public:
 
 	void SetSlotIndex(int32 Index) { SlotIndex = Index; }
 
+	FORCEINLINE void SetItemCount(int32 Count) { ItemCount = Count; }
+
+	FORCEINLINE void SetItemRarity(EItemRarity Rarity) { ItemRarity = Rarity; }
+
 	FORCEINLINE void SetCharacter(AShooterCharacter* Char) { Character = Char; }
 
 	FORCEINLINE void SetCharacterInventoryFull(bool bFull) { bCharacterInventoryFull = bFull; }
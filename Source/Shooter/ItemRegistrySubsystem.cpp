@@ -0,0 +1,214 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ItemRegistrySubsystem.h"
+
+#include "Item.h"
+#include "Shooter.h"
+#include "Components/BoxComponent.h"
+#include "Curves/CurveVector.h"
+#include "Materials/MaterialParameterCollection.h"
+#include "Materials/MaterialParameterCollectionInstance.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Registered Items"), STAT_RegisteredItems, STATGROUP_Shooter);
+DECLARE_CYCLE_STAT(TEXT("Item Registry Query"), STAT_ItemRegistryQuery, STATGROUP_Shooter);
+DECLARE_CYCLE_STAT(TEXT("Item Pulse Update"), STAT_ItemPulseUpdate, STATGROUP_Shooter);
+
+namespace
+{
+	const TCHAR* PulseCurvePath{TEXT("CurveVector'/Game/_Game/Curves/MaterialPulseCurve.MaterialPulseCurve'")};
+
+	/** Scalar params of the pulse collection */
+	const FName PulseTimeParameter{TEXT("ItemPulseTime")};
+	const FName PulseGlowParameter{TEXT("ItemPulseGlow")};
+	const FName PulseFresnelExponentParameter{TEXT("ItemPulseFresnelExponent")};
+	const FName PulseFresnelReflectFractionParameter{TEXT("ItemPulseFresnelReflectFraction")};
+}
+
+UItemRegistrySubsystem::UItemRegistrySubsystem():
+	CellSize(500.f),
+	PulseParameterCollection(nullptr),
+	PulseCurve(nullptr),
+	PulsePeriod(5.f),
+	ViewCheckInterval(0.25f),
+	TimeSinceViewCheck(0.f)
+{
+}
+
+void UItemRegistrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Without a collection the pickups pulse from their own curve, nothing to load
+	if (PulseParameterCollectionAsset.IsNull()) return;
+
+	PulseParameterCollection = PulseParameterCollectionAsset.LoadSynchronous();
+	PulseCurve = Cast<UCurveVector>(StaticLoadObject(UCurveVector::StaticClass(), nullptr, PulseCurvePath));
+}
+
+void UItemRegistrySubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_RegisteredItems, ItemCells.Num());
+	Cells.Empty();
+	ItemCells.Empty();
+	PulseParameterCollection = nullptr;
+	PulseCurve = nullptr;
+
+	Super::Deinitialize();
+}
+
+void UItemRegistrySubsystem::RegisterItem(AItem* Item)
+{
+	if (Item == nullptr) return;
+
+	const FIntVector Cell{GetCell(GetItemQueryLocation(Item))};
+	if (const FIntVector* CurrentCell = ItemCells.Find(Item))
+	{
+		// Already in the right cell
+		if (*CurrentCell == Cell) return;
+		UnregisterItem(Item);
+	}
+
+	Cells.FindOrAdd(Cell).Add(Item);
+	ItemCells.Add(Item, Cell);
+	INC_DWORD_STAT(STAT_RegisteredItems);
+}
+
+void UItemRegistrySubsystem::UnregisterItem(AItem* Item)
+{
+	FIntVector Cell;
+	if (!ItemCells.RemoveAndCopyValue(Item, Cell)) return;
+
+	if (TArray<TWeakObjectPtr<AItem>>* CellItems = Cells.Find(Cell))
+	{
+		CellItems->RemoveSwap(Item);
+		if (CellItems->Num() == 0)
+		{
+			Cells.Remove(Cell);
+		}
+	}
+	DEC_DWORD_STAT(STAT_RegisteredItems);
+}
+
+void UItemRegistrySubsystem::QueryItems(const FVector& Origin, float Radius, TArray<AItem*>& OutItems) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ItemRegistryQuery);
+
+	const FIntVector MinCell{GetCell(Origin - FVector(Radius))};
+	const FIntVector MaxCell{GetCell(Origin + FVector(Radius))};
+	const float RadiusSquared{Radius * Radius};
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				const TArray<TWeakObjectPtr<AItem>>* CellItems = Cells.Find(FIntVector(X, Y, Z));
+				if (CellItems == nullptr) continue;
+
+				for (const TWeakObjectPtr<AItem>& WeakItem : *CellItems)
+				{
+					AItem* Item = WeakItem.Get();
+					if (Item && FVector::DistSquared(GetItemQueryLocation(Item), Origin) <= RadiusSquared)
+					{
+						OutItems.Add(Item);
+					}
+				}
+			}
+		}
+	}
+}
+
+AItem* UItemRegistrySubsystem::FindBestItemInCone(const FVector& Origin, float Radius, const FVector& ViewOrigin,
+                                                  const FVector& ViewDirection, float MaxAngle) const
+{
+	TArray<AItem*> NearbyItems;
+	QueryItems(Origin, Radius, NearbyItems);
+
+	// Item with the smallest angle to the view ray wins
+	AItem* BestItem{nullptr};
+	float BestCosAngle{FMath::Cos(FMath::DegreesToRadians(MaxAngle))};
+	for (AItem* Item : NearbyItems)
+	{
+		const FVector ToItem{(GetItemQueryLocation(Item) - ViewOrigin).GetSafeNormal()};
+		const float CosAngle{FVector::DotProduct(ToItem, ViewDirection)};
+		if (CosAngle >= BestCosAngle)
+		{
+			BestCosAngle = CosAngle;
+			BestItem = Item;
+		}
+	}
+	return BestItem;
+}
+
+FVector UItemRegistrySubsystem::GetItemQueryLocation(const AItem* Item)
+{
+	// The collision box is what the crossHair trace used to hit
+	if (Item->GetCollisionBox())
+	{
+		return Item->GetCollisionBox()->Bounds.Origin;
+	}
+	return Item->GetActorLocation();
+}
+
+FIntVector UItemRegistrySubsystem::GetCell(const FVector& Location) const
+{
+	return FIntVector(FMath::FloorToInt(Location.X / CellSize),
+	                  FMath::FloorToInt(Location.Y / CellSize),
+	                  FMath::FloorToInt(Location.Z / CellSize));
+}
+
+void UItemRegistrySubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ItemPulseUpdate);
+
+	// One timer for all the pickups pulsing on their own, they tick only while rendered
+	if (PulseParameterCollection == nullptr)
+	{
+		TimeSinceViewCheck += DeltaTime;
+		if (TimeSinceViewCheck < ViewCheckInterval) return;
+		TimeSinceViewCheck = 0.f;
+
+		for (const auto& ItemCellPair : ItemCells)
+		{
+			if (AItem* Item = ItemCellPair.Key.Get())
+			{
+				Item->UpdateTickEnabled();
+			}
+		}
+		return;
+	}
+
+	UMaterialParameterCollectionInstance* PulseParameters = GetWorld()->GetParameterCollectionInstance(
+		PulseParameterCollection);
+	if (PulseParameters == nullptr) return;
+
+	// One write per frame for every pickup, the materials do the rest
+	const float PulseTime{FMath::Fmod(GetWorld()->GetTimeSeconds(), PulsePeriod)};
+	PulseParameters->SetScalarParameterValue(PulseTimeParameter, PulseTime);
+
+	if (PulseCurve)
+	{
+		const FVector CurveValue{PulseCurve->GetVectorValue(PulseTime)};
+		PulseParameters->SetScalarParameterValue(PulseGlowParameter, CurveValue.X);
+		PulseParameters->SetScalarParameterValue(PulseFresnelExponentParameter, CurveValue.Y);
+		PulseParameters->SetScalarParameterValue(PulseFresnelReflectFractionParameter, CurveValue.Z);
+	}
+}
+
+ETickableTickType UItemRegistrySubsystem::GetTickableTickType() const
+{
+	// The class default object never ticks
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UItemRegistrySubsystem::IsTickable() const
+{
+	return ItemCells.Num() > 0;
+}
+
+TStatId UItemRegistrySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UItemRegistrySubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ItemRegistrySubsystem.generated.h"
+
+class AItem;
+class UCurveVector;
+class UMaterialParameterCollection;
+
+/**
+ * Uniform grid of the items lying in the world in the PickUp state,
+ * used to find the item under the crossHairs without tracing every frame.
+ * Also drives the glow pulse shared by all those items through a material parameter collection,
+ * or without one, checks at a low rate which of them are in view and should tick their own pulse
+ */
+UCLASS(Config=Game)
+class SHOOTER_API UItemRegistrySubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UItemRegistrySubsystem();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	/** Add the item to the grid cell at its current location */
+	void RegisterItem(AItem* Item);
+
+	/** Remove the item from the grid, safe to call for items that are not registered */
+	void UnregisterItem(AItem* Item);
+
+	/** Gather the registered items within Radius of Origin */
+	void QueryItems(const FVector& Origin, float Radius, TArray<AItem*>& OutItems) const;
+
+	/**
+	 * Item within Radius of Origin closest to the view ray, null if none is inside the cone
+	 * @param ViewOrigin Start of the view ray
+	 * @param ViewDirection Normalized direction of the view ray
+	 * @param MaxAngle Half angle of the cone around the view ray in degrees
+	 */
+	AItem* FindBestItemInCone(const FVector& Origin, float Radius, const FVector& ViewOrigin,
+	                          const FVector& ViewDirection, float MaxAngle) const;
+
+	/** Location used for distance and angle checks, the center of the item bounds */
+	static FVector GetItemQueryLocation(const AItem* Item);
+
+	/** True when the pulse collection exists, otherwise the pickups pulse from their own curve */
+	FORCEINLINE bool HasSharedPulse() const { return PulseParameterCollection != nullptr; }
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+private:
+	FIntVector GetCell(const FVector& Location) const;
+
+	/** Size of a grid cell, should be about the size of the query radius */
+	float CellSize;
+
+	/** Items registered in each grid cell */
+	TMap<FIntVector, TArray<TWeakObjectPtr<AItem>>> Cells;
+
+	/** Cell each item was registered in */
+	TMap<TWeakObjectPtr<AItem>, FIntVector> ItemCells;
+
+	/** Collection the pickup materials read the shared pulse from, none until it is set in DefaultGame.ini */
+	UPROPERTY(Config)
+	TSoftObjectPtr<UMaterialParameterCollection> PulseParameterCollectionAsset;
+
+	UPROPERTY()
+	UMaterialParameterCollection* PulseParameterCollection;
+
+	/** Glow amount, fresnel exponent and reflect fraction over one pulse */
+	UPROPERTY()
+	UCurveVector* PulseCurve;
+
+	/** Length of one pulse in seconds */
+	float PulsePeriod;
+
+	/** Seconds between two view checks of the pickups pulsing on their own */
+	float ViewCheckInterval;
+
+	float TimeSinceViewCheck;
+};
@@ -0,0 +1,356 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PickupManagerSubsystem.h"
+
+#include "Ammo.h"
+#include "BoostPickUp.h"
+#include "Shooter.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Dormant Pickups"), STAT_DormantPickups, STATGROUP_Shooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Promoted Pickups"), STAT_PromotedPickups, STATGROUP_Shooter);
+DECLARE_CYCLE_STAT(TEXT("Pickup Manager Update"), STAT_PickupManagerUpdate, STATGROUP_Shooter);
+
+UPickupManagerSubsystem::UPickupManagerSubsystem():
+	PromoteRadius(800.f),
+	DemoteRadius(1000.f),
+	UpdateInterval(0.25f),
+	TimeSinceUpdate(0.f),
+	CellSize(1000.f),
+	PromotingRecord(INDEX_NONE)
+{
+}
+
+void UPickupManagerSubsystem::Deinitialize()
+{
+	for (const TPair<UStaticMesh*, FPickupInstances>& Pair : Instances)
+	{
+		if (Pair.Value.Component)
+		{
+			Pair.Value.Component->DestroyComponent();
+		}
+	}
+	int32 DormantCount{0};
+	for (const TPair<FIntVector, TArray<int32>>& Cell : DormantCells)
+	{
+		DormantCount += Cell.Value.Num();
+	}
+	DEC_DWORD_STAT_BY(STAT_DormantPickups, DormantCount);
+	DEC_DWORD_STAT_BY(STAT_PromotedPickups, PromotedRecords.Num());
+
+	Instances.Empty();
+	Records.Empty();
+	FreeRecords.Empty();
+	DormantCells.Empty();
+	PromotedRecords.Empty();
+
+	Super::Deinitialize();
+}
+
+void UPickupManagerSubsystem::RegisterPickup(AActor* Pickup)
+{
+	if (Pickup == nullptr) return;
+
+	// Actor spawned by PromotePickup
+	if (PromotingRecord != INDEX_NONE)
+	{
+		Records[PromotingRecord].Actor = Pickup;
+		return;
+	}
+
+	const int32 RecordIndex{AllocateRecord()};
+	Records[RecordIndex].Actor = Pickup;
+	PromotedRecords.Add(RecordIndex);
+	INC_DWORD_STAT(STAT_PromotedPickups);
+}
+
+void UPickupManagerSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceUpdate += DeltaTime;
+	if (TimeSinceUpdate < UpdateInterval) return;
+	TimeSinceUpdate = 0.f;
+
+	UpdatePickups();
+}
+
+void UPickupManagerSubsystem::UpdatePickups()
+{
+	SCOPE_CYCLE_COUNTER(STAT_PickupManagerUpdate);
+
+	TArray<FVector, TInlineAllocator<4>> PlayerLocations;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (PlayerController && PlayerController->GetPawn())
+		{
+			PlayerLocations.Add(PlayerController->GetPawn()->GetActorLocation());
+		}
+	}
+
+	// Demote the idle actors every player has left, forget the ones that were picked up
+	const float DemoteRadiusSquared{DemoteRadius * DemoteRadius};
+	for (int32 Index = PromotedRecords.Num() - 1; Index >= 0; --Index)
+	{
+		const int32 RecordIndex{PromotedRecords[Index]};
+		const AActor* Pickup = Records[RecordIndex].Actor.Get();
+		if (Pickup == nullptr)
+		{
+			PromotedRecords.RemoveAtSwap(Index, 1, false);
+			DEC_DWORD_STAT(STAT_PromotedPickups);
+			FreeRecord(RecordIndex);
+			continue;
+		}
+
+		bool bPlayerInRange{false};
+		for (const FVector& PlayerLocation : PlayerLocations)
+		{
+			if (FVector::DistSquared(PlayerLocation, Pickup->GetActorLocation()) <= DemoteRadiusSquared)
+			{
+				bPlayerInRange = true;
+				break;
+			}
+		}
+		if (!bPlayerInRange && CanDemote(Pickup))
+		{
+			PromotedRecords.RemoveAtSwap(Index, 1, false);
+			DEC_DWORD_STAT(STAT_PromotedPickups);
+			DemotePickup(RecordIndex);
+		}
+	}
+
+	// Promote the dormant pickups in range of a player
+	const float PromoteRadiusSquared{PromoteRadius * PromoteRadius};
+	TArray<int32> RecordsToPromote;
+	for (const FVector& PlayerLocation : PlayerLocations)
+	{
+		const FIntVector MinCell{GetCell(PlayerLocation - FVector(PromoteRadius))};
+		const FIntVector MaxCell{GetCell(PlayerLocation + FVector(PromoteRadius))};
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			{
+				for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+				{
+					const TArray<int32>* CellRecords = DormantCells.Find(FIntVector(X, Y, Z));
+					if (CellRecords == nullptr) continue;
+
+					for (const int32 RecordIndex : *CellRecords)
+					{
+						const FVector Location{Records[RecordIndex].Transform.GetLocation()};
+						if (FVector::DistSquared(PlayerLocation, Location) <= PromoteRadiusSquared)
+						{
+							RecordsToPromote.AddUnique(RecordIndex);
+						}
+					}
+				}
+			}
+		}
+	}
+	for (const int32 RecordIndex : RecordsToPromote)
+	{
+		PromotePickup(RecordIndex);
+	}
+}
+
+void UPickupManagerSubsystem::PromotePickup(int32 RecordIndex)
+{
+	FDormantPickup& Record = Records[RecordIndex];
+	if (Record.PickupClass == nullptr) return;
+
+	AActor* Pickup = GetWorld()->SpawnActorDeferred<AActor>(Record.PickupClass, Record.Transform, nullptr, nullptr,
+	                                                        ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (Pickup == nullptr) return;
+
+	ApplyRecord(Record, Pickup);
+
+	// BeginPlay registers the actor back to this record
+	PromotingRecord = RecordIndex;
+	Pickup->FinishSpawning(Record.Transform);
+	PromotingRecord = INDEX_NONE;
+
+	// Other pickups spawned during BeginPlay may have grown Records
+	FDormantPickup& PromotedRecord = Records[RecordIndex];
+	PromotedRecord.Actor = Pickup;
+
+	const FIntVector Cell{GetCell(PromotedRecord.Transform.GetLocation())};
+	if (TArray<int32>* CellRecords = DormantCells.Find(Cell))
+	{
+		CellRecords->RemoveSwap(RecordIndex);
+		if (CellRecords->Num() == 0)
+		{
+			DormantCells.Remove(Cell);
+		}
+	}
+	ReleaseInstance(PromotedRecord.Mesh, PromotedRecord.InstanceIndex);
+	PromotedRecord.InstanceIndex = INDEX_NONE;
+
+	PromotedRecords.Add(RecordIndex);
+	DEC_DWORD_STAT(STAT_DormantPickups);
+	INC_DWORD_STAT(STAT_PromotedPickups);
+}
+
+void UPickupManagerSubsystem::DemotePickup(int32 RecordIndex)
+{
+	FDormantPickup& Record = Records[RecordIndex];
+	AActor* Pickup = Record.Actor.Get();
+	if (!CaptureRecord(Pickup, Record))
+	{
+		// Not a pickup we can draw instanced, leave the actor alone
+		FreeRecord(RecordIndex);
+		return;
+	}
+
+	Record.InstanceIndex = AddInstance(Record.Mesh, Record.Transform, GetPickupMesh(Pickup));
+	Record.Actor.Reset();
+	Pickup->Destroy();
+
+	DormantCells.FindOrAdd(GetCell(Record.Transform.GetLocation())).Add(RecordIndex);
+	INC_DWORD_STAT(STAT_DormantPickups);
+}
+
+bool UPickupManagerSubsystem::CaptureRecord(AActor* Pickup, FDormantPickup& Record)
+{
+	const UStaticMeshComponent* Mesh = GetPickupMesh(Pickup);
+	if (Mesh == nullptr || Mesh->GetStaticMesh() == nullptr) return false;
+
+	Record.PickupClass = Pickup->GetClass();
+	Record.Mesh = Mesh->GetStaticMesh();
+	Record.Transform = Pickup->GetActorTransform();
+
+	if (const AAmmo* Ammo = Cast<AAmmo>(Pickup))
+	{
+		Record.Type = static_cast<uint8>(Ammo->GetAmmoType());
+		Record.Rarity = Ammo->GetItemRarity();
+		Record.Count = Ammo->GetItemCount();
+	}
+	else if (const ABoostPickUp* BoostPickUp = Cast<ABoostPickUp>(Pickup))
+	{
+		Record.Type = static_cast<uint8>(BoostPickUp->GetBoostPickUpType());
+		Record.Amount = BoostPickUp->GetHealingAmount();
+	}
+	return true;
+}
+
+void UPickupManagerSubsystem::ApplyRecord(const FDormantPickup& Record, AActor* Pickup)
+{
+	if (AAmmo* Ammo = Cast<AAmmo>(Pickup))
+	{
+		Ammo->SetAmmoType(static_cast<EAmmoType>(Record.Type));
+		Ammo->SetItemRarity(Record.Rarity);
+		Ammo->SetItemCount(Record.Count);
+	}
+	else if (ABoostPickUp* BoostPickUp = Cast<ABoostPickUp>(Pickup))
+	{
+		BoostPickUp->SetBoostPickUpType(static_cast<EBoostPickUpType>(Record.Type));
+		BoostPickUp->SetHealingAmount(Record.Amount);
+	}
+}
+
+bool UPickupManagerSubsystem::CanDemote(const AActor* Pickup)
+{
+	// Ammo being interped or already picked up stays an actor
+	if (const AAmmo* Ammo = Cast<AAmmo>(Pickup))
+	{
+		return Ammo->GetItemState() == EItemState::EIS_PickUp;
+	}
+	return Cast<ABoostPickUp>(Pickup) != nullptr;
+}
+
+UStaticMeshComponent* UPickupManagerSubsystem::GetPickupMesh(const AActor* Pickup)
+{
+	if (const AAmmo* Ammo = Cast<AAmmo>(Pickup))
+	{
+		return Ammo->GetAmmoMesh();
+	}
+	if (const ABoostPickUp* BoostPickUp = Cast<ABoostPickUp>(Pickup))
+	{
+		return BoostPickUp->GetPickUpMesh();
+	}
+	return nullptr;
+}
+
+int32 UPickupManagerSubsystem::AllocateRecord()
+{
+	const int32 RecordIndex{FreeRecords.Num() > 0 ? FreeRecords.Pop(false) : Records.AddDefaulted()};
+	Records[RecordIndex] = FDormantPickup();
+	return RecordIndex;
+}
+
+void UPickupManagerSubsystem::FreeRecord(int32 RecordIndex)
+{
+	Records[RecordIndex] = FDormantPickup();
+	FreeRecords.Add(RecordIndex);
+}
+
+int32 UPickupManagerSubsystem::AddInstance(UStaticMesh* Mesh, const FTransform& Transform,
+                                           const UStaticMeshComponent* Source)
+{
+	FPickupInstances& MeshInstances = Instances.FindOrAdd(Mesh);
+	if (MeshInstances.Component == nullptr)
+	{
+		UWorld* World = GetWorld();
+
+		// Same outer as the pooled FX components
+		UInstancedStaticMeshComponent* Component = NewObject<UInstancedStaticMeshComponent>(World->GetWorldSettings());
+		Component->SetMobility(EComponentMobility::Movable);
+		Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Component->SetCanEverAffectNavigation(false);
+		Component->SetStaticMesh(Mesh);
+		if (Source)
+		{
+			for (int32 MaterialIndex = 0; MaterialIndex < Source->GetNumMaterials(); ++MaterialIndex)
+			{
+				Component->SetMaterial(MaterialIndex, Source->GetMaterial(MaterialIndex));
+			}
+		}
+		Component->RegisterComponentWithWorld(World);
+		MeshInstances.Component = Component;
+	}
+
+	if (MeshInstances.FreeInstances.Num() > 0)
+	{
+		const int32 InstanceIndex{MeshInstances.FreeInstances.Pop(false)};
+		MeshInstances.Component->UpdateInstanceTransform(InstanceIndex, Transform, true, true, true);
+		return InstanceIndex;
+	}
+	return MeshInstances.Component->AddInstanceWorldSpace(Transform);
+}
+
+void UPickupManagerSubsystem::ReleaseInstance(UStaticMesh* Mesh, int32 InstanceIndex)
+{
+	FPickupInstances* MeshInstances = Instances.Find(Mesh);
+	if (MeshInstances == nullptr || MeshInstances->Component == nullptr || InstanceIndex == INDEX_NONE) return;
+
+	// Removing would shift the indices of every other instance, a zero scale instance is simply not drawn
+	FTransform HiddenTransform;
+	MeshInstances->Component->GetInstanceTransform(InstanceIndex, HiddenTransform, true);
+	HiddenTransform.SetScale3D(FVector::ZeroVector);
+	MeshInstances->Component->UpdateInstanceTransform(InstanceIndex, HiddenTransform, true, true, true);
+	MeshInstances->FreeInstances.Add(InstanceIndex);
+}
+
+FIntVector UPickupManagerSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntVector(FMath::FloorToInt(Location.X / CellSize),
+	                  FMath::FloorToInt(Location.Y / CellSize),
+	                  FMath::FloorToInt(Location.Z / CellSize));
+}
+
+ETickableTickType UPickupManagerSubsystem::GetTickableTickType() const
+{
+	// The class default object never ticks
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UPickupManagerSubsystem::IsTickable() const
+{
+	return Records.Num() > FreeRecords.Num();
+}
+
+TStatId UPickupManagerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPickupManagerSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,152 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Item.h"
+#include "Tickable.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PickupManagerSubsystem.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+class UStaticMeshComponent;
+
+/** Everything needed to spawn a pickup actor back, kept while the pickup is dormant */
+USTRUCT()
+struct FDormantPickup
+{
+	GENERATED_BODY()
+
+	/** Class spawned when the pickup is promoted */
+	UPROPERTY()
+	UClass* PickupClass = nullptr;
+
+	/** Mesh drawn by the instanced component while dormant */
+	UPROPERTY()
+	UStaticMesh* Mesh = nullptr;
+
+	FTransform Transform;
+
+	/** Live actor while promoted */
+	TWeakObjectPtr<AActor> Actor;
+
+	/** Instance in the instanced component of Mesh while dormant, INDEX_NONE while promoted */
+	int32 InstanceIndex = INDEX_NONE;
+
+	/** Ammo type or boost type */
+	uint8 Type = 0;
+
+	EItemRarity Rarity = EItemRarity::EIR_Common;
+
+	/** Ammo count */
+	int32 Count = 0;
+
+	/** Healing amount of a boost */
+	float Amount = 0.f;
+};
+
+/** Instanced component of one pickup mesh and its zero scaled instances ready to be reused */
+USTRUCT()
+struct FPickupInstances
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UInstancedStaticMeshComponent* Component = nullptr;
+
+	TArray<int32> FreeInstances;
+};
+
+/**
+ * Keeps the ammo and boost pickups away from the players as instanced static meshes
+ * with a small record, and spawns the real actor only when a player comes within range.
+ * The actor is turned back into an instance once every player has left
+ */
+UCLASS()
+class SHOOTER_API UPickupManagerSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UPickupManagerSubsystem();
+
+	virtual void Deinitialize() override;
+
+	/**
+	 * Called by pickups on BeginPlay, the pickup is demoted on the next update
+	 * if no player is close to it
+	 */
+	void RegisterPickup(AActor* Pickup);
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+private:
+	/** Promote dormant pickups near a player and demote promoted ones every player has left */
+	void UpdatePickups();
+
+	/** Spawn the actor of a dormant record */
+	void PromotePickup(int32 RecordIndex);
+
+	/** Replace the actor of a promoted record by an instance */
+	void DemotePickup(int32 RecordIndex);
+
+	/** Fill the record from a pickup actor, false if the actor can't be dormant */
+	static bool CaptureRecord(AActor* Pickup, FDormantPickup& Record);
+
+	/** Restore the record on a pickup spawned deferred, before it finishes spawning */
+	static void ApplyRecord(const FDormantPickup& Record, AActor* Pickup);
+
+	/** True when the pickup is idle and can be turned back into an instance */
+	static bool CanDemote(const AActor* Pickup);
+
+	/** Mesh component drawn for the pickup */
+	static UStaticMeshComponent* GetPickupMesh(const AActor* Pickup);
+
+	int32 AllocateRecord();
+	void FreeRecord(int32 RecordIndex);
+
+	/** Instance of Mesh at the transform, reuses a zero scaled instance if any */
+	int32 AddInstance(UStaticMesh* Mesh, const FTransform& Transform, const UStaticMeshComponent* Source);
+
+	/** Hide the instance by scaling it to zero and keep it for reuse */
+	void ReleaseInstance(UStaticMesh* Mesh, int32 InstanceIndex);
+
+	FIntVector GetCell(const FVector& Location) const;
+
+	/** Within this distance of a player a dormant pickup gets its actor back */
+	float PromoteRadius;
+
+	/** Beyond this distance of every player the actor is demoted, larger than PromoteRadius to avoid flickering */
+	float DemoteRadius;
+
+	/** Seconds between two updates */
+	float UpdateInterval;
+
+	float TimeSinceUpdate;
+
+	/** Size of a grid cell of dormant records */
+	float CellSize;
+
+	UPROPERTY()
+	TArray<FDormantPickup> Records;
+
+	TArray<int32> FreeRecords;
+
+	/** Dormant records in each grid cell */
+	TMap<FIntVector, TArray<int32>> DormantCells;
+
+	/** Records whose actor is live */
+	TArray<int32> PromotedRecords;
+
+	/** Record being promoted, so the spawned actor links to it on BeginPlay */
+	int32 PromotingRecord;
+
+	UPROPERTY()
+	TMap<UStaticMesh*, FPickupInstances> Instances;
+};
@@ -0,0 +1,176 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ProjectileSubsystem.h"
+
+#include "Shooter.h"
+#include "ShooterCharacter.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Projectiles"), STAT_Projectiles, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectile Sweeps"), STAT_ProjectileSweeps, STATGROUP_Shooter);
+DECLARE_CYCLE_STAT(TEXT("Projectile Step"), STAT_ProjectileStep, STATGROUP_Shooter);
+
+void UProjectileSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SweepDelegate.BindUObject(this, &UProjectileSubsystem::OnSweepDone);
+}
+
+void UProjectileSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_Projectiles, Ids.Num());
+	Ids.Empty();
+	Positions.Empty();
+	SweepStarts.Empty();
+	Velocities.Empty();
+	GravityScales.Empty();
+	Drags.Empty();
+	Lifetimes.Empty();
+	Damages.Empty();
+	HeadShotDamages.Empty();
+	Shooters.Empty();
+	IdToIndex.Empty();
+	SweepDelegate.Unbind();
+
+	Super::Deinitialize();
+}
+
+void UProjectileSubsystem::LaunchProjectile(AShooterCharacter* Shooter, const FVector& Location,
+                                            const FVector& Velocity, const FProjectileParams& Params)
+{
+	if (Params.Lifetime <= 0.f) return;
+
+	const uint32 ProjectileId = NextProjectileId++;
+	IdToIndex.Add(ProjectileId, Ids.Num());
+	Ids.Add(ProjectileId);
+	Positions.Add(Location);
+	SweepStarts.Add(Location);
+	Velocities.Add(Velocity);
+	GravityScales.Add(Params.GravityScale);
+	Drags.Add(Params.Drag);
+	Lifetimes.Add(Params.Lifetime);
+	Damages.Add(Params.Damage);
+	HeadShotDamages.Add(Params.HeadShotDamage);
+	Shooters.Add(Shooter);
+	INC_DWORD_STAT(STAT_Projectiles);
+}
+
+void UProjectileSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ProjectileStep);
+
+	StepProjectiles(DeltaTime);
+
+	// Expired projectiles are dropped before their last step is traced
+	for (int32 Index = Lifetimes.Num() - 1; Index >= 0; --Index)
+	{
+		if (Lifetimes[Index] <= 0.f)
+		{
+			RemoveAt(Index);
+		}
+	}
+
+	SubmitSweeps();
+}
+
+void UProjectileSubsystem::StepProjectiles(float DeltaTime)
+{
+	const float GravityZ{GetWorld()->GetGravityZ()};
+	const int32 Count{Positions.Num()};
+
+	FVector* RESTRICT PositionData = Positions.GetData();
+	FVector* RESTRICT SweepStartData = SweepStarts.GetData();
+	FVector* RESTRICT VelocityData = Velocities.GetData();
+	float* RESTRICT LifetimeData = Lifetimes.GetData();
+	const float* RESTRICT GravityScaleData = GravityScales.GetData();
+	const float* RESTRICT DragData = Drags.GetData();
+
+	// No branch and no other object touched, the compiler can vectorize the step
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		SweepStartData[Index] = PositionData[Index];
+
+		// Semi implicit Euler, the velocity first then the position with the new velocity
+		const FVector Acceleration{
+			-VelocityData[Index].X * DragData[Index],
+			-VelocityData[Index].Y * DragData[Index],
+			GravityZ * GravityScaleData[Index] - VelocityData[Index].Z * DragData[Index]
+		};
+		VelocityData[Index] += Acceleration * DeltaTime;
+		PositionData[Index] += VelocityData[Index] * DeltaTime;
+		LifetimeData[Index] -= DeltaTime;
+	}
+}
+
+void UProjectileSubsystem::SubmitSweeps()
+{
+	UWorld* World = GetWorld();
+	for (int32 Index = 0; Index < Ids.Num(); ++Index)
+	{
+		// The shooter never stops its own projectiles
+		const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ProjectileSweep), false, Shooters[Index].Get());
+		World->AsyncLineTraceByChannel(EAsyncTraceType::Single, SweepStarts[Index], Positions[Index], ECC_Visibility,
+		                               QueryParams, FCollisionResponseParams::DefaultResponseParam,
+		                               &SweepDelegate, Ids[Index]);
+	}
+	INC_DWORD_STAT_BY(STAT_ProjectileSweeps, Ids.Num());
+}
+
+void UProjectileSubsystem::OnSweepDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	if (TraceDatum.OutHits.Num() == 0 || !TraceDatum.OutHits[0].bBlockingHit) return;
+
+	// Gone when an earlier step already hit, or expired
+	const int32* Index = IdToIndex.Find(TraceDatum.UserData);
+	if (Index == nullptr) return;
+
+	AShooterCharacter* Shooter = Shooters[*Index].Get();
+	const float Damage{Damages[*Index]};
+	const float HeadShotDamage{HeadShotDamages[*Index]};
+	RemoveAt(*Index);
+
+	if (Shooter)
+	{
+		Shooter->ResolveProjectileHit(TraceDatum.OutHits[0], Damage, HeadShotDamage);
+	}
+}
+
+void UProjectileSubsystem::RemoveAt(int32 Index)
+{
+	IdToIndex.Remove(Ids[Index]);
+
+	Ids.RemoveAtSwap(Index, 1, false);
+	Positions.RemoveAtSwap(Index, 1, false);
+	SweepStarts.RemoveAtSwap(Index, 1, false);
+	Velocities.RemoveAtSwap(Index, 1, false);
+	GravityScales.RemoveAtSwap(Index, 1, false);
+	Drags.RemoveAtSwap(Index, 1, false);
+	Lifetimes.RemoveAtSwap(Index, 1, false);
+	Damages.RemoveAtSwap(Index, 1, false);
+	HeadShotDamages.RemoveAtSwap(Index, 1, false);
+	Shooters.RemoveAtSwap(Index, 1, false);
+
+	// The last projectile moved into the hole
+	if (Ids.IsValidIndex(Index))
+	{
+		IdToIndex.Add(Ids[Index], Index);
+	}
+	DEC_DWORD_STAT(STAT_Projectiles);
+}
+
+ETickableTickType UProjectileSubsystem::GetTickableTickType() const
+{
+	// The class default object never ticks
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UProjectileSubsystem::IsTickable() const
+{
+	return Ids.Num() > 0;
+}
+
+TStatId UProjectileSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UProjectileSubsystem, STATGROUP_Tickables);
+}
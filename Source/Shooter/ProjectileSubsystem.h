@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "WorldCollision.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ProjectileSubsystem.generated.h"
+
+class AShooterCharacter;
+
+/* Flight and damage of a projectile, captured at launch since the weapon may be swapped before it lands */
+struct FProjectileParams
+{
+	/* Scale of the world gravity, 0 flies straight */
+	float GravityScale = 1.f;
+
+	/* Velocity lost per second, proportional to the velocity */
+	float Drag = 0.f;
+
+	/* Seconds before the projectile is dropped without hitting anything */
+	float Lifetime = 5.f;
+
+	float Damage = 0.f;
+	float HeadShotDamage = 0.f;
+};
+
+/**
+ * Simulates every travel time projectile of the world without an actor each.
+ * Projectiles are kept in parallel arrays and stepped in one loop with gravity and drag,
+ * then the segment each moved along this frame is traced in one batch of async traces.
+ * A hit removes the projectile and is resolved by the shooter like a hitscan bullet
+ */
+UCLASS()
+class SHOOTER_API UProjectileSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	void LaunchProjectile(AShooterCharacter* Shooter, const FVector& Location, const FVector& Velocity,
+	                      const FProjectileParams& Params);
+
+	FORCEINLINE int32 GetNumProjectiles() const { return Ids.Num(); }
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+private:
+	/** Move every projectile one step and age it */
+	void StepProjectiles(float DeltaTime);
+
+	/** Queue the trace along the last step of every projectile */
+	void SubmitSweeps();
+
+	void OnSweepDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	/** Swap the last projectile into the hole */
+	void RemoveAt(int32 Index);
+
+	FTraceDelegate SweepDelegate;
+
+	/* Projectile columns, same order in every array */
+	TArray<uint32> Ids;
+	TArray<FVector> Positions;
+	TArray<FVector> SweepStarts;
+	TArray<FVector> Velocities;
+	TArray<float> GravityScales;
+	TArray<float> Drags;
+	TArray<float> Lifetimes;
+	TArray<float> Damages;
+	TArray<float> HeadShotDamages;
+	TArray<TWeakObjectPtr<AShooterCharacter>> Shooters;
+
+	/* Index in the columns of each projectile id, the traces come back with the id */
+	TMap<uint32, int32> IdToIndex;
+
+	uint32 NextProjectileId = 0;
+};
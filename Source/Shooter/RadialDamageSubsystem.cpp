@@ -0,0 +1,152 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RadialDamageSubsystem.h"
+
+#include "DamageQueueSubsystem.h"
+#include "Shooter.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Radial Damage Occlusion Traces"), STAT_RadialDamageTraces, STATGROUP_Shooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pending Radial Damage"), STAT_PendingRadialDamage, STATGROUP_Shooter);
+
+void URadialDamageSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	OverlapDelegate.BindUObject(this, &URadialDamageSubsystem::OnOverlapDone);
+	OcclusionTraceDelegate.BindUObject(this, &URadialDamageSubsystem::OnOcclusionTraceDone);
+}
+
+void URadialDamageSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_PendingRadialDamage, PendingRequests.Num());
+	PendingRequests.Empty();
+	PendingTraces.Empty();
+	OverlapDelegate.Unbind();
+	OcclusionTraceDelegate.Unbind();
+
+	Super::Deinitialize();
+}
+
+void URadialDamageSubsystem::ApplyRadialDamage(const FRadialDamageRequest& Request)
+{
+	if (Request.OuterRadius <= 0.f || Request.BaseDamage <= 0.f) return;
+
+	const uint32 RequestId = NextRequestId++;
+	FPendingRadialDamage& PendingRequest = PendingRequests.Add(RequestId);
+	PendingRequest.Request = Request;
+	PendingRequest.SourceActor = Request.SourceActor;
+	PendingRequest.DamageCauser = Request.DamageCauser;
+	PendingRequest.InstigatorController = Request.InstigatorController;
+	INC_DWORD_STAT(STAT_PendingRadialDamage);
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(RadialDamageOverlap), false, Request.SourceActor);
+	GetWorld()->AsyncOverlapByChannel(Request.Origin, FQuat::Identity, ECC_Pawn,
+	                                  FCollisionShape::MakeSphere(Request.OuterRadius), QueryParams,
+	                                  FCollisionResponseParams::DefaultResponseParam, &OverlapDelegate, RequestId);
+}
+
+float URadialDamageSubsystem::GetDamageScale(const FRadialDamageRequest& Request, float Distance)
+{
+	if (Distance <= Request.InnerRadius) return 1.f;
+	if (Distance >= Request.OuterRadius) return 0.f;
+
+	// Same curve as FRadialDamageParams
+	const float FalloffRange{FMath::Max(Request.OuterRadius - Request.InnerRadius, KINDA_SMALL_NUMBER)};
+	return FMath::Pow(1.f - (Distance - Request.InnerRadius) / FalloffRange, Request.DamageFalloff);
+}
+
+void URadialDamageSubsystem::OnOverlapDone(const FTraceHandle& TraceHandle, FOverlapDatum& OverlapDatum)
+{
+	const uint32 RequestId = OverlapDatum.UserData;
+	FPendingRadialDamage* PendingRequest = PendingRequests.Find(RequestId);
+	if (PendingRequest == nullptr) return;
+
+	const FRadialDamageRequest& Request = PendingRequest->Request;
+
+	// Several components of an actor can overlap, damage each actor once
+	TSet<AActor*> Candidates;
+	for (const FOverlapResult& Overlap : OverlapDatum.OutOverlaps)
+	{
+		AActor* Actor = Overlap.GetActor();
+		if (Actor && Actor->IsA(Request.DamagedClass))
+		{
+			Candidates.Add(Actor);
+		}
+	}
+
+	// Submit the occlusion traces of every candidate together
+	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(RadialDamageOcclusion), false);
+	if (PendingRequest->SourceActor.IsValid())
+	{
+		TraceParams.AddIgnoredActor(PendingRequest->SourceActor.Get());
+	}
+	for (AActor* Candidate : Candidates)
+	{
+		const FVector TargetLocation{Candidate->GetActorLocation()};
+		const float Damage{
+			FMath::Lerp(Request.MinimumDamage, Request.BaseDamage,
+			            GetDamageScale(Request, FVector::Dist(Request.Origin, TargetLocation)))
+		};
+		if (Damage <= 0.f) continue;
+
+		const uint32 TraceId = NextTraceId++;
+		FPendingOcclusionTrace& PendingTrace = PendingTraces.Add(TraceId);
+		PendingTrace.RequestId = RequestId;
+		PendingTrace.Target = Candidate;
+		PendingTrace.Damage = Damage;
+		++PendingRequest->PendingTraces;
+
+		GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, Request.Origin, TargetLocation, ECC_Visibility,
+		                                    TraceParams, FCollisionResponseParams::DefaultResponseParam,
+		                                    &OcclusionTraceDelegate, TraceId);
+		INC_DWORD_STAT(STAT_RadialDamageTraces);
+	}
+
+	if (PendingRequest->PendingTraces == 0)
+	{
+		ResolveRequest(RequestId);
+	}
+}
+
+void URadialDamageSubsystem::OnOcclusionTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	FPendingOcclusionTrace PendingTrace;
+	if (!PendingTraces.RemoveAndCopyValue(TraceDatum.UserData, PendingTrace)) return;
+
+	FPendingRadialDamage* PendingRequest = PendingRequests.Find(PendingTrace.RequestId);
+	if (PendingRequest == nullptr) return;
+
+	// Visible when nothing but the target itself is in the way
+	const bool bBlocked = TraceDatum.OutHits.Num() > 0 && TraceDatum.OutHits[0].bBlockingHit &&
+		TraceDatum.OutHits[0].GetActor() != PendingTrace.Target.Get();
+	if (!bBlocked && PendingTrace.Target.IsValid())
+	{
+		PendingRequest->Hits.Emplace(PendingTrace.Target, PendingTrace.Damage);
+	}
+
+	if (--PendingRequest->PendingTraces == 0)
+	{
+		ResolveRequest(PendingTrace.RequestId);
+	}
+}
+
+void URadialDamageSubsystem::ResolveRequest(uint32 RequestId)
+{
+	FPendingRadialDamage PendingRequest;
+	if (!PendingRequests.RemoveAndCopyValue(RequestId, PendingRequest)) return;
+	DEC_DWORD_STAT(STAT_PendingRadialDamage);
+
+	const TSubclassOf<UDamageType> DamageTypeClass{
+		PendingRequest.Request.DamageTypeClass ? PendingRequest.Request.DamageTypeClass : UDamageType::StaticClass()
+	};
+	for (const TPair<TWeakObjectPtr<AActor>, float>& Hit : PendingRequest.Hits)
+	{
+		if (AActor* Target = Hit.Key.Get())
+		{
+			UDamageQueueSubsystem::QueueDamage(Target, Hit.Value, PendingRequest.InstigatorController.Get(),
+			                                   PendingRequest.DamageCauser.Get(), DamageTypeClass);
+		}
+	}
+}
@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldCollision.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RadialDamageSubsystem.generated.h"
+
+/* Parameters of a radial damage event, e.g. an explosion */
+struct FRadialDamageRequest
+{
+	FVector Origin = FVector::ZeroVector;
+
+	/* Damage inside InnerRadius, falls off to MinimumDamage at OuterRadius */
+	float BaseDamage = 0.f;
+	float MinimumDamage = 0.f;
+	float InnerRadius = 0.f;
+	float OuterRadius = 0.f;
+
+	/* Exponent of the falloff between the inner and outer radius, 1 is linear */
+	float DamageFalloff = 1.f;
+
+	/* Only actors of this class take damage */
+	TSubclassOf<AActor> DamagedClass = AActor::StaticClass();
+
+	TSubclassOf<UDamageType> DamageTypeClass;
+
+	/* Actor the damage comes from, ignored by the queries */
+	AActor* SourceActor = nullptr;
+
+	AActor* DamageCauser = nullptr;
+	AController* InstigatorController = nullptr;
+};
+
+/**
+ * Radial damage resolved with an async overlap, then one batch of async occlusion traces
+ * to the actors found. Damage is applied once the traces come back on a later frame
+ */
+UCLASS()
+class SHOOTER_API URadialDamageSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	/** Start the overlap query of the request */
+	void ApplyRadialDamage(const FRadialDamageRequest& Request);
+
+	/** Damage scale at Distance from the origin, 1 inside the inner radius and 0 at the outer radius */
+	static float GetDamageScale(const FRadialDamageRequest& Request, float Distance);
+
+private:
+	/* A request waiting on its async queries */
+	struct FPendingRadialDamage
+	{
+		FRadialDamageRequest Request;
+
+		/* The request pointers may be destroyed before the queries come back */
+		TWeakObjectPtr<AActor> SourceActor;
+		TWeakObjectPtr<AActor> DamageCauser;
+		TWeakObjectPtr<AController> InstigatorController;
+
+		/* Occlusion traces not back yet */
+		int32 PendingTraces = 0;
+
+		/* Visible actors and the damage to apply to them */
+		TArray<TPair<TWeakObjectPtr<AActor>, float>> Hits;
+	};
+
+	/* An occlusion trace toward one candidate */
+	struct FPendingOcclusionTrace
+	{
+		uint32 RequestId = 0;
+		TWeakObjectPtr<AActor> Target;
+		float Damage = 0.f;
+	};
+
+	void OnOverlapDone(const FTraceHandle& TraceHandle, FOverlapDatum& OverlapDatum);
+
+	void OnOcclusionTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	/** Apply the damage of a request whose traces are all back */
+	void ResolveRequest(uint32 RequestId);
+
+	FOverlapDelegate OverlapDelegate;
+	FTraceDelegate OcclusionTraceDelegate;
+
+	TMap<uint32, FPendingRadialDamage> PendingRequests;
+	TMap<uint32, FPendingOcclusionTrace> PendingTraces;
+
+	uint32 NextRequestId = 0;
+	uint32 NextTraceId = 0;
+};
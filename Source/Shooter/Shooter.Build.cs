@@ -9,7 +9,7 @@ public class Shooter : ModuleRules
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
 		PublicDependencyModuleNames.AddRange(new string[]
-			{ "Core", "CoreUObject", "Engine", "InputCore", "UMG", "PhysicsCore","NavigationSystem","AIModule","Niagara" });
+			{ "Core", "CoreUObject", "Engine", "InputCore", "UMG", "PhysicsCore","NavigationSystem","AIModule","GameplayTasks","Niagara" });
 
 		PrivateDependencyModuleNames.AddRange(new string[] { });
 
@@ -4,6 +4,9 @@
 
 #include "CoreMinimal.h"
 
+DECLARE_STATS_GROUP(TEXT("Shooter"), STATGROUP_Shooter, STATCAT_Advanced);
+DECLARE_STATS_GROUP(TEXT("ShooterStreaming"), STATGROUP_ShooterStreaming, STATCAT_Advanced);
+
 #define EPS_Metal EPhysicalSurface::SurfaceType1
 #define EPS_Stone EPhysicalSurface::SurfaceType2
 #define EPS_Tile EPhysicalSurface::SurfaceType3
@@ -5,8 +5,16 @@
 #include "ShooterCharacter.h"
 #include "Weapon.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "ThreadSafeAnimInstanceProxy.h"
 #include "Kismet/KismetMathLibrary.h"
 
+namespace
+{
+	/** Curve names hashed once instead of every frame */
+	const FName TurningCurveName{TEXT("Turning")};
+	const FName RotationCurveName{TEXT("Rotation")};
+}
+
 UShooterAnimInstance::UShooterAnimInstance():
 	Speed(0.f),
 	bIsInAir(false),
@@ -28,104 +36,147 @@ UShooterAnimInstance::UShooterAnimInstance():
 	bTurningInPlace(false),
 	bEquipping(false),
 	EquippedWeaponType(EWeaponType::EWT_MAX),
-	bShouldUseFABRIK(false)
+	bShouldUseFABRIK(false),
+	TurningCurveUID(SmartName::MaxUID),
+	RotationCurveUID(SmartName::MaxUID)
 
 {
 }
 
 void UShooterAnimInstance::UpdateAnimationProperties(float DeltaTime)
+{
+}
+
+void UShooterAnimInstance::NativeInitializeAnimation()
+{
+	Super::NativeInitializeAnimation();
+
+	ShooterCharacter = Cast<AShooterCharacter>(TryGetPawnOwner());
+
+	TurningCurveUID = SmartName::MaxUID;
+	RotationCurveUID = SmartName::MaxUID;
+	if (const USkeleton* Skeleton = CurrentSkeleton)
+	{
+		TurningCurveUID = Skeleton->GetUIDByName(USkeleton::AnimCurveMappingName, TurningCurveName);
+		RotationCurveUID = Skeleton->GetUIDByName(USkeleton::AnimCurveMappingName, RotationCurveName);
+	}
+}
+
+void UShooterAnimInstance::SnapshotGameThreadState(float DeltaTime)
 {
 	if (ShooterCharacter == nullptr)
 	{
 		ShooterCharacter = Cast<AShooterCharacter>(TryGetPawnOwner());
 	}
 
-	if (ShooterCharacter)
+	Snapshot.bValid = ShooterCharacter != nullptr;
+	if (ShooterCharacter == nullptr) return;
+
+	const UCharacterMovementComponent* CharacterMovement = ShooterCharacter->GetCharacterMovement();
+	Snapshot.Velocity = ShooterCharacter->GetVelocity();
+	Snapshot.bIsFalling = CharacterMovement->IsFalling();
+	Snapshot.bIsAccelerating = CharacterMovement->GetCurrentAcceleration().Size() > 0.f;
+	Snapshot.BaseAimRotation = ShooterCharacter->GetBaseAimRotation();
+	Snapshot.ActorRotation = ShooterCharacter->GetActorRotation();
+	Snapshot.CombatState = ShooterCharacter->GetCombatState();
+	Snapshot.bCrouching = ShooterCharacter->GetCrouching();
+	Snapshot.bAiming = ShooterCharacter->GetAiming();
+
+	const AWeapon* EquippedWeapon = ShooterCharacter->GetEquippedWeapon();
+	Snapshot.bHasEquippedWeapon = EquippedWeapon != nullptr;
+	if (EquippedWeapon)
 	{
-		bCrouching = ShooterCharacter->GetCrouching();
-		bReloading = ShooterCharacter->GetCombatState() == ECombatState::ECS_Reloading;
-		bEquipping = ShooterCharacter->GetCombatState() == ECombatState::ECS_Equipping;
-		bShouldUseFABRIK = ShooterCharacter->GetCombatState() == ECombatState::ECS_Unoccupied || ShooterCharacter->
-			GetCombatState() == ECombatState::ECS_FireTimerInProgress;
+		Snapshot.EquippedWeaponType = EquippedWeapon->GetWeaponType();
+	}
 
-		//Get the lateral speed of the character from Velocity
-		FVector Velocity{ShooterCharacter->GetVelocity()};
-		Velocity.Z = 0.f;
-		Speed = Velocity.Size();
+	// Curves of the last evaluation, looked up by UID instead of by name
+	const FBlendedHeapCurve& AnimCurves = GetSkelMeshComponent()->AnimCurves;
+	Snapshot.TurningCurve = TurningCurveUID != SmartName::MaxUID ? AnimCurves.Get(TurningCurveUID) : 0.f;
+	Snapshot.RotationCurve = RotationCurveUID != SmartName::MaxUID ? AnimCurves.Get(RotationCurveUID) : 0.f;
+}
 
+void UShooterAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaTime)
+{
+	if (!Snapshot.bValid) return;
 
-		//Is The character in the air
-		bIsInAir = ShooterCharacter->GetCharacterMovement()->IsFalling();
+	bCrouching = Snapshot.bCrouching;
+	bReloading = Snapshot.CombatState == ECombatState::ECS_Reloading;
+	bEquipping = Snapshot.CombatState == ECombatState::ECS_Equipping;
+	bShouldUseFABRIK = Snapshot.CombatState == ECombatState::ECS_Unoccupied || Snapshot.CombatState ==
+		ECombatState::ECS_FireTimerInProgress;
 
+	//Get the lateral speed of the character from Velocity
+	FVector Velocity{Snapshot.Velocity};
+	Velocity.Z = 0.f;
+	Speed = Velocity.Size();
 
-		//Is the character accelerating
-		if (ShooterCharacter->GetCharacterMovement()->GetCurrentAcceleration().Size() > 0.f)
-		{
-			bIsAccelerating = true;
-		}
-		else
-		{
-			bIsAccelerating = false;
-		}
 
+	//Is The character in the air
+	bIsInAir = Snapshot.bIsFalling;
 
-		FRotator AimRotation = ShooterCharacter->GetBaseAimRotation();
-		FRotator MovementRotation = UKismetMathLibrary::MakeRotFromX(ShooterCharacter->GetVelocity());
 
-		MovementOffsetYaw = UKismetMathLibrary::NormalizedDeltaRotator(MovementRotation, AimRotation).Yaw;
+	//Is the character accelerating
+	bIsAccelerating = Snapshot.bIsAccelerating;
 
-		if (ShooterCharacter->GetVelocity().Size() > 0.f)
-		{
-			LastMovementOffsetYaw = MovementOffsetYaw;
-		}
-		bAiming = ShooterCharacter->GetAiming();
 
-		if (bReloading)
-		{
-			OffsetState = EOffsetState::EOS_Reloading;
-		}
-		else if (bIsInAir)
-		{
-			OffsetState = EOffsetState::EOS_InAir;
-		}
-		else if (ShooterCharacter->GetAiming())
-		{
-			OffsetState = EOffsetState::EOS_Aiming;
-		}
-		else
-		{
-			OffsetState = EOffsetState::EOS_Hip;
-		}
+	const FRotator AimRotation = Snapshot.BaseAimRotation;
+	const FRotator MovementRotation = UKismetMathLibrary::MakeRotFromX(Snapshot.Velocity);
 
-		// Check if shooter character has a valid Equipped weapon
-		if (ShooterCharacter->GetEquippedWeapon())
-		{
-			EquippedWeaponType = ShooterCharacter->GetEquippedWeapon()->GetWeaponType();
-		}
+	MovementOffsetYaw = UKismetMathLibrary::NormalizedDeltaRotator(MovementRotation, AimRotation).Yaw;
+
+	if (Snapshot.Velocity.Size() > 0.f)
+	{
+		LastMovementOffsetYaw = MovementOffsetYaw;
+	}
+	bAiming = Snapshot.bAiming;
+
+	if (bReloading)
+	{
+		OffsetState = EOffsetState::EOS_Reloading;
+	}
+	else if (bIsInAir)
+	{
+		OffsetState = EOffsetState::EOS_InAir;
+	}
+	else if (bAiming)
+	{
+		OffsetState = EOffsetState::EOS_Aiming;
 	}
+	else
+	{
+		OffsetState = EOffsetState::EOS_Hip;
+	}
+
+	// Check if shooter character has a valid Equipped weapon
+	if (Snapshot.bHasEquippedWeapon)
+	{
+		EquippedWeaponType = Snapshot.EquippedWeaponType;
+	}
+
 	TurnInPlace();
 
 	Lean(DeltaTime);
 }
 
-void UShooterAnimInstance::NativeInitializeAnimation()
+FAnimInstanceProxy* UShooterAnimInstance::CreateAnimInstanceProxy()
 {
-	Super::NativeInitializeAnimation();
+	return new TThreadSafeAnimInstanceProxy<UShooterAnimInstance>(this);
+}
 
-	ShooterCharacter = Cast<AShooterCharacter>(TryGetPawnOwner());
+void UShooterAnimInstance::DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy)
+{
+	delete InProxy;
 }
 
 void UShooterAnimInstance::TurnInPlace()
 {
-	if (ShooterCharacter == nullptr) return;
-
-	Pitch = ShooterCharacter->GetBaseAimRotation().Pitch;
+	Pitch = Snapshot.BaseAimRotation.Pitch;
 
 	if (Speed > 0.f || bIsInAir)
 	{
 		// Dont want to turn in place character is moving
 		RootYawOffset = 0.f;
-		TIPCharacterYaw = ShooterCharacter->GetActorRotation().Yaw;
+		TIPCharacterYaw = Snapshot.ActorRotation.Yaw;
 		TIPCharacterYawLastFrame = TIPCharacterYaw;
 		RotationCurve = 0.f;
 		RotationCurveLastFrame = 0.f;
@@ -133,21 +184,21 @@ void UShooterAnimInstance::TurnInPlace()
 	else
 	{
 		TIPCharacterYawLastFrame = TIPCharacterYaw;
-		TIPCharacterYaw = ShooterCharacter->GetActorRotation().Yaw;
+		TIPCharacterYaw = Snapshot.ActorRotation.Yaw;
 
 		const float TIPYawDelta{TIPCharacterYaw - TIPCharacterYawLastFrame};
 
 		// Root Yaw offset updated and clamped to [-180, 180] 
 		RootYawOffset = UKismetMathLibrary::NormalizeAxis(RootYawOffset - TIPYawDelta);
 
-		const float Turning{GetCurveValue(TEXT("Turning"))};
+		const float Turning{Snapshot.TurningCurve};
 
 		// 1.0  if Turning 0.0 if not 
 		if (Turning > 0)
 		{
 			bTurningInPlace = true;
 			RotationCurveLastFrame = RotationCurve;
-			RotationCurve = GetCurveValue(TEXT("Rotation"));
+			RotationCurve = Snapshot.RotationCurve;
 
 			const float DeltaRotation{RotationCurve - RotationCurveLastFrame};
 
@@ -209,10 +260,8 @@ void UShooterAnimInstance::TurnInPlace()
 
 void UShooterAnimInstance::Lean(float DeltaTime)
 {
-	if (ShooterCharacter == nullptr)return;
-
 	CharacterRotationLastFrame = CharacterRotation;
-	CharacterRotation = ShooterCharacter->GetActorRotation();
+	CharacterRotation = Snapshot.ActorRotation;
 
 	const FRotator Delta{UKismetMathLibrary::NormalizedDeltaRotator(CharacterRotation, CharacterRotationLastFrame)};
 
@@ -19,6 +19,41 @@ enum class EOffsetState : uint8
 	EOS_Max UMETA(DisplayName="Default Max"),
 };
 
+enum class ECombatState : uint8;
+
+/** Character state copied on the game thread for the worker thread update */
+struct FShooterAnimSnapshot
+{
+	FVector Velocity = FVector::ZeroVector;
+
+	FRotator BaseAimRotation = FRotator::ZeroRotator;
+
+	FRotator ActorRotation = FRotator::ZeroRotator;
+
+	ECombatState CombatState{};
+
+	/** Type of the equipped weapon, only meaningful with bHasEquippedWeapon */
+	EWeaponType EquippedWeaponType = EWeaponType::EWT_MAX;
+
+	/** Value of the Turning curve last evaluation */
+	float TurningCurve = 0.f;
+
+	/** Value of the Rotation curve last evaluation */
+	float RotationCurve = 0.f;
+
+	bool bIsFalling = false;
+
+	bool bIsAccelerating = false;
+
+	bool bCrouching = false;
+
+	bool bAiming = false;
+
+	bool bHasEquippedWeapon = false;
+
+	bool bValid = false;
+};
+
 /**
  * 
  */
@@ -30,14 +65,25 @@ class SHOOTER_API UShooterAnimInstance : public UAnimInstance
 public:
 	UShooterAnimInstance();
 
+	/** Kept for the animation blueprint, the properties are now updated natively on the animation worker */
 	UFUNCTION(BlueprintCallable)
 	void UpdateAnimationProperties(float DeltaTime);
 
 
 	virtual void NativeInitializeAnimation() override;
 
+	/** Copy the character state and the curves, game thread */
+	void SnapshotGameThreadState(float DeltaTime);
+
+	/** Derive the animation properties from the snapshot, any thread */
+	void NativeThreadSafeUpdateAnimation(float DeltaTime);
+
 
 protected:
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override;
+
+	virtual void DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy) override;
+
 	/** Handle turning in place variables */
 	void TurnInPlace();
 
@@ -133,4 +179,10 @@ private:
 	/* True when not reloading or equipping  */
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category="Combat", meta=(AllowPrivateAccess="true"))
 	bool bShouldUseFABRIK;
+
+	FShooterAnimSnapshot Snapshot;
+
+	/** Curve UIDs on the skeleton, resolved once in NativeInitializeAnimation */
+	SmartName::UID_Type TurningCurveUID;
+	SmartName::UID_Type RotationCurveUID;
 };
@@ -5,11 +5,16 @@
 
 #include "Ammo.h"
 #include "BulletHitInterface.h"
+#include "CooldownComponent.h"
+#include "DamageQueueSubsystem.h"
 #include "DrawDebugHelpers.h"
 #include "Enemy.h"
 #include "EnemyController.h"
 #include "Explosive.h"
+#include "FXPoolSubsystem.h"
 #include "Item.h"
+#include "ItemRegistrySubsystem.h"
+#include "ProjectileSubsystem.h"
 #include "Shooter.h"
 #include "Camera/CameraComponent.h"
 #include "Components/WidgetComponent.h"
@@ -21,9 +26,15 @@
 #include "Sound/SoundCue.h"
 #include "Weapon.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
 #include "Components/CapsuleComponent.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("CrossHair Ray Cache Hits"), STAT_CrossHairRayCacheHits, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CrossHair Ray Cache Misses"), STAT_CrossHairRayCacheMisses, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CrossHair Trace Cache Hits"), STAT_CrossHairTraceCacheHits, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CrossHair Trace Cache Misses"), STAT_CrossHairTraceCacheMisses, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Auto Fire Catch Up Shots"), STAT_AutoFireCatchUpShots, STATGROUP_Shooter);
 
 // Sets default values
 AShooterCharacter::AShooterCharacter():
@@ -64,7 +75,6 @@ AShooterCharacter::AShooterCharacter():
 
 	//Bullet Fire Timer variables
 	ShootTimeDuration(0.05f),
-	bFiringBullet(false),
 
 	//Automatic  fire variables 
 	bShouldFire(true),
@@ -72,6 +82,15 @@ AShooterCharacter::AShooterCharacter():
 
 	//Item Trace Variables 
 	bShouldTraceForItems(false),
+	ItemQueryRadius(250.f),
+	ItemQueryAngle(8.f),
+	bConfirmItemTrace(true),
+
+	//Async hitscan variables
+	bAsyncHitscan(true),
+	NextHitscanShotId(0),
+	MaxAutoFireShotsPerFrame(8),
+	NextSpreadSeed(0),
 
 	//Camera Interp locations  Variables 
 	CameraInterpDistance(250.f),
@@ -98,9 +117,7 @@ AShooterCharacter::AShooterCharacter():
 	//Aiming
 	bAimingButtonPressed(false),
 
-	//PickUp Sound Timer properties
-	bShouldPlayEquipSound(true),
-	bShouldPlayPickUpSound(true),
+	//PickUp Sound cooldown properties
 	PickUpSoundResetTime(0.2f),
 	EquipeSoundResetTime(0.2f),
 
@@ -145,6 +162,8 @@ AShooterCharacter::AShooterCharacter():
 	GetCharacterMovement()->JumpZVelocity = 600.f;
 	GetCharacterMovement()->AirControl = 0.2f;
 
+	Cooldowns = CreateDefaultSubobject<UCooldownComponent>(TEXT("Cooldowns"));
+
 	//Create Hand scene component 
 	HandSceneComponent = CreateDefaultSubobject<USceneComponent>(TEXT("HandSceneComp"));
 
@@ -178,7 +197,8 @@ float AShooterCharacter::TakeDamage(float DamageAmount, FDamageEvent const& Dama
 		const auto EnemyController = Cast<AEnemyController>(EventInstigator);
 		if (EnemyController)
 		{
-			EnemyController->GetBlackboardComponent()->SetValueAsBool(FName("IsCharacterDead"), true);
+			EnemyController->GetBlackboardComponent()->SetValue<UBlackboardKeyType_Bool>(
+				EnemyController->GetBlackboardKeys().IsCharacterDead, true);
 		}
 	}
 	else
@@ -219,6 +239,10 @@ void AShooterCharacter::BeginPlay()
 
 	//Create FInterpLocation struct for each interp location , Add to Array
 	InitializeInterpLocations();
+
+	//Bind the async hitscan trace callbacks
+	CrossHairTraceDelegate.BindUObject(this, &AShooterCharacter::OnCrossHairTraceDone);
+	BarrelTraceDelegate.BindUObject(this, &AShooterCharacter::OnBarrelTraceDone);
 }
 
 // Called every frame
@@ -226,6 +250,9 @@ void AShooterCharacter::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	// Fire rate cooldown over, fire again or reload
+	UpdateAutoFire();
+
 	//Handle Interpolation when Zoom While Aiming 
 	CameraInterpolationZoom(DeltaTime);
 
@@ -293,14 +320,14 @@ void AShooterCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCo
 	PlayerInputComponent->BindAction("5Key", IE_Pressed, this, &AShooterCharacter::FiveKeyPressed);
 }
 
-void AShooterCharacter::ResetPickUpSoundTimer()
+bool AShooterCharacter::ShouldPlayPickUpSound() const
 {
-	bShouldPlayPickUpSound = true;
+	return Cooldowns->IsReady(ECooldown::ECD_PickUpSound);
 }
 
-void AShooterCharacter::ResetEquipSoundTimer()
+bool AShooterCharacter::ShouldPlayEquipSound() const
 {
-	bShouldPlayEquipSound = true;
+	return Cooldowns->IsReady(ECooldown::ECD_EquipSound);
 }
 
 float AShooterCharacter::GetCrossHairSpreadMultiplier() const
@@ -379,18 +406,14 @@ void AShooterCharacter::IncrementInterpLocItemCount(int32 Index, int32 Amount)
 	}
 }
 
-void AShooterCharacter::StartPickUpSoundTimer()
+void AShooterCharacter::StartPickUpSoundCooldown()
 {
-	bShouldPlayPickUpSound = false;
-	GetWorldTimerManager().SetTimer(PickUpSoundTimer, this, &AShooterCharacter::ResetPickUpSoundTimer,
-	                                PickUpSoundResetTime);
+	Cooldowns->StartCooldown(ECooldown::ECD_PickUpSound, PickUpSoundResetTime);
 }
 
-void AShooterCharacter::StartEquipSoundTimer()
+void AShooterCharacter::StartEquipSoundCooldown()
 {
-	bShouldPlayEquipSound = false;
-	GetWorldTimerManager().SetTimer(EquipSoundTimer, this, &AShooterCharacter::ResetEquipSoundTimer,
-	                                EquipeSoundResetTime);
+	Cooldowns->StartCooldown(ECooldown::ECD_EquipSound, EquipeSoundResetTime);
 }
 
 void AShooterCharacter::MoveForward(float Value)
@@ -469,31 +492,72 @@ void AShooterCharacter::FireWeapon()
 	if (CombatState != ECombatState::ECS_Unoccupied)return;
 	if (WeaponHasAmmo())
 	{
-		//Play Fire Sound 
-		PlayFireSound();
+		FireShots(1, GetWorld()->GetTimeSeconds());
+	}
+}
+
+void AShooterCharacter::FireShots(int32 ShotCount, float FirstShotTime)
+{
+	// Never more shots than rounds in the magazine
+	ShotCount = FMath::Min(ShotCount, EquippedWeapon->GetAmmo());
+	if (ShotCount <= 0) return;
 
-		// Send Bullet 
-		SendBullet();
+	const float LastShotTime{FirstShotTime + (ShotCount - 1) * EquippedWeapon->GetAutoFireRate()};
 
-		// Play Fire Montage
-		PlayGunFireMontage();
+	//Play Fire Sound 
+	PlayFireSound();
 
-		//Start Bullet Fire Timer for crossHairs
-		StartCrossHairBulletFire();
+	// Send Bullet 
+	SendBullet(ShotCount);
 
-		//Subtract 1 from the Weapons Ammo
+	// Play Fire Montage
+	PlayGunFireMontage();
+
+	//Start Bullet Fire Timer for crossHairs
+	StartCrossHairBulletFire(LastShotTime);
+
+	//Subtract the shots from the Weapons Ammo
+	for (int32 Shot = 0; Shot < ShotCount; ++Shot)
+	{
 		EquippedWeapon->DecrementAmmo();
+	}
 
-		StartFireTimer();
+	StartFireTimer(LastShotTime);
 
-		if (EquippedWeapon->GetWeaponType() == EWeaponType::EWT_Pistol)
-		{
-			//Start moving slide timer
-			EquippedWeapon->StartSlideTimer();
-		}
+	if (EquippedWeapon->GetWeaponType() == EWeaponType::EWT_Pistol)
+	{
+		//Start moving slide timer
+		EquippedWeapon->StartSlideTimer();
 	}
 }
 
+void AShooterCharacter::UpdateAutoFire()
+{
+	if (CombatState != ECombatState::ECS_FireTimerInProgress || !Cooldowns->IsReady(ECooldown::ECD_AutoFire)) return;
+
+	if (EquippedWeapon == nullptr || !bFireButtonPressed || !EquippedWeapon->GetAutomatic() || !WeaponHasAmmo())
+	{
+		AutoFireReset();
+		return;
+	}
+
+	// The next shot was due when the cooldown ended, not this frame: fire every shot due since then
+	const float FireRate{FMath::Max(EquippedWeapon->GetAutoFireRate(), KINDA_SMALL_NUMBER)};
+	const float TimeSeconds{GetWorld()->GetTimeSeconds()};
+	float FirstShotTime{Cooldowns->GetReadyTime(ECooldown::ECD_AutoFire)};
+	int32 ShotCount{1 + FMath::FloorToInt((TimeSeconds - FirstShotTime) / FireRate)};
+	if (ShotCount > MaxAutoFireShotsPerFrame)
+	{
+		// Drop the rest of a hitch instead of emptying the magazine in one frame
+		ShotCount = FMath::Max(MaxAutoFireShotsPerFrame, 1);
+		FirstShotTime = TimeSeconds - (ShotCount - 1) * FireRate;
+	}
+	INC_DWORD_STAT_BY(STAT_AutoFireCatchUpShots, ShotCount - 1);
+
+	CombatState = ECombatState::ECS_Unoccupied;
+	FireShots(ShotCount, FirstShotTime);
+}
+
 bool AShooterCharacter::GetBeamEndLocation(const FVector& MuzzleSocketEndLocation, FHitResult& OutHitResult)
 {
 	FVector OutBeamLocation;
@@ -514,8 +578,7 @@ bool AShooterCharacter::GetBeamEndLocation(const FVector& MuzzleSocketEndLocatio
 
 	// Perform a second trace this time from the gun barrel
 	const FVector WeaponTraceStart{MuzzleSocketEndLocation};
-	const FVector StartToEnd{OutBeamLocation - MuzzleSocketEndLocation};
-	const FVector WeaponTraceEnd{MuzzleSocketEndLocation + StartToEnd * 1.25f};
+	const FVector WeaponTraceEnd{GetWeaponTraceEnd(MuzzleSocketEndLocation, OutBeamLocation)};
 	GetWorld()->LineTraceSingleByChannel(OutHitResult, WeaponTraceStart, WeaponTraceEnd, ECC_Visibility);
 
 	if (!OutHitResult.bBlockingHit) //Object between barrel and hit point
@@ -609,7 +672,7 @@ void AShooterCharacter::CalculateCrossHairsSpread(float DeltaTime)
 	}
 
 	//True 0.05s after firing 
-	if (bFiringBullet)
+	if (!Cooldowns->IsReady(ECooldown::ECD_CrossHairShoot))
 	{
 		CrossHairShootingFactor = FMath::FInterpTo(CrossHairShootingFactor, 0.3f, DeltaTime, 60.f);
 	}
@@ -622,17 +685,9 @@ void AShooterCharacter::CalculateCrossHairsSpread(float DeltaTime)
 		CrossHairShootingFactor;
 }
 
-void AShooterCharacter::StartCrossHairBulletFire()
-{
-	bFiringBullet = true;
-
-	GetWorldTimerManager().SetTimer(CrossHairShootTimer, this, &AShooterCharacter::FinishCrossHairBulletFire,
-	                                ShootTimeDuration);
-}
-
-void AShooterCharacter::FinishCrossHairBulletFire()
+void AShooterCharacter::StartCrossHairBulletFire(float LastShotTime)
 {
-	bFiringBullet = false;
+	Cooldowns->StartCooldownAt(ECooldown::ECD_CrossHairShoot, LastShotTime, ShootTimeDuration);
 }
 
 void AShooterCharacter::FireButtonPressed()
@@ -646,13 +701,12 @@ void AShooterCharacter::FireButtonReleased()
 	bFireButtonPressed = false;
 }
 
-void AShooterCharacter::StartFireTimer()
+void AShooterCharacter::StartFireTimer(float LastShotTime)
 {
 	if (EquippedWeapon == nullptr) return;
 
 	CombatState = ECombatState::ECS_FireTimerInProgress;
-	GetWorldTimerManager().SetTimer(AutoFireTimer, this, &AShooterCharacter::AutoFireReset,
-	                                EquippedWeapon->GetAutoFireRate());
+	Cooldowns->StartCooldownAt(ECooldown::ECD_AutoFire, LastShotTime, EquippedWeapon->GetAutoFireRate());
 }
 
 void AShooterCharacter::AutoFireReset()
@@ -683,7 +737,7 @@ void AShooterCharacter::PlayFireSound()
 	}
 }
 
-void AShooterCharacter::SendBullet()
+void AShooterCharacter::SendBullet(int32 ShotCount)
 {
 	//Send bullet
 	const USkeletalMeshSocket* BarrelSocket = EquippedWeapon->GetItemSkeletalMesh()->
@@ -693,78 +747,387 @@ void AShooterCharacter::SendBullet()
 		// If Barrel Socket Get transform
 		const FTransform SocketTransform = BarrelSocket->GetSocketTransform(EquippedWeapon->GetItemSkeletalMesh());
 
-		if (EquippedWeapon->GetMuzzleFlash())
+		UFXPoolSubsystem* FXPool = GetWorld()->GetSubsystem<UFXPoolSubsystem>();
+		if (FXPool && EquippedWeapon->GetMuzzleFlash())
 		{
 			// if MuzzleFlash Spawn it at barrelSocket location with transform 
-			UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), EquippedWeapon->GetMuzzleFlash(), SocketTransform);
+			FXPool->SpawnFX(EquippedWeapon->GetMuzzleFlash(), SocketTransform);
 		}
 
-		FHitResult BeamHitResult;
-		// Get Beam end Location 
-		bool bBeamEnd = GetBeamEndLocation(SocketTransform.GetLocation(), BeamHitResult);
+		const int32 PelletCount{EquippedWeapon->GetPelletCount()};
+		const int32 SpreadSeed{NextSpreadSeed};
+		NextSpreadSeed += ShotCount;
 
-		if (bBeamEnd)
+		if (EquippedWeapon->GetProjectileSpeed() > 0.f)
 		{
-			// Does Hit Actor implement bulletHitInterface
-			if (BeamHitResult.Actor.IsValid())
-			{
-				IBulletHitInterface* BulletHitInterface = Cast<IBulletHitInterface>(BeamHitResult.Actor.Get());
+			LaunchProjectiles(SocketTransform, ShotCount, SpreadSeed);
+			return;
+		}
 
-				if (BulletHitInterface)
+		if (bAsyncHitscan)
+		{
+			// Queue the crossHair trace, the shot resolves once the barrel trace comes back
+			FVector CrossHairWorldPosition;
+			FVector CrossHairWorldDirection;
+			if (DeprojectCrossHair(CrossHairWorldPosition, CrossHairWorldDirection))
+			{
+				const uint32 ShotId = NextHitscanShotId++;
+				const FVector Start{CrossHairWorldPosition};
+				const FVector End{Start + CrossHairWorldDirection * 50000.f};
+
+				FHitscanShot& Shot = PendingHitscanShots.Add(ShotId);
+				Shot.SocketTransform = SocketTransform;
+				Shot.Damage = EquippedWeapon->GetDamage();
+				Shot.HeadShotDamage = EquippedWeapon->GetHeadShotDamage();
+				Shot.BeamEndLocation = End;
+				Shot.ShotCount = ShotCount;
+				Shot.PelletCount = PelletCount;
+				Shot.PelletSpreadAngle = EquippedWeapon->GetPelletSpreadAngle();
+				Shot.SpreadSeed = SpreadSeed;
+				Shot.PendingTraces = 0;
+
+				if (CrossHairCache.bTraceCached)
 				{
-					BulletHitInterface->BulletHit_Implementation(BeamHitResult, this, GetController());
+					// The crossHair was already traced this frame, go straight to the barrel trace
+					INC_DWORD_STAT(STAT_CrossHairTraceCacheHits);
+					SubmitBarrelTrace(ShotId, CrossHairCache.HitLocation);
+					return;
 				}
 
-				AEnemy* HitEnemy = Cast<AEnemy>(BeamHitResult.Actor.Get());
-				if (HitEnemy)
-				{
-					int32 Damage{};
-					bool bHeadShot = false;
-					if (BeamHitResult.BoneName.ToString() == HitEnemy->GetHeadBone())
-					{
-						// HeadShot
-						Damage = EquippedWeapon->GetHeadShotDamage();
-						bHeadShot = true;
-					}
-					else
-					{
-						// Body Shot
-						Damage = EquippedWeapon->GetDamage();
-						bHeadShot = false;
-					}
-					UGameplayStatics::ApplyDamage(BeamHitResult.Actor.Get(), Damage,
-					                              GetController(), this, UDamageType::StaticClass());
-
-					HitEnemy->ShowHitNumber(Damage, BeamHitResult.Location, bHeadShot);
-				}
-				AExplosive* HitExplosive = Cast<AExplosive>(BeamHitResult.Actor.Get());
-				if (HitExplosive)
-				{
-					UGameplayStatics::ApplyDamage(BeamHitResult.Actor.Get(), EquippedWeapon->GetDamage(),
-					                              GetController(), this, UDamageType::StaticClass());
-				}
+				GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End, ECC_Visibility,
+				                                    FCollisionQueryParams::DefaultQueryParam,
+				                                    FCollisionResponseParams::DefaultResponseParam,
+				                                    &CrossHairTraceDelegate, ShotId);
 			}
-			else
+			return;
+		}
+
+		if (PelletCount > 1)
+		{
+			// Every pellet aims at the crossHair hit, spread in the cone
+			FHitResult CrossHairHitResult;
+			FVector BeamEndLocation;
+			TraceUnderCrossHair(CrossHairHitResult, BeamEndLocation);
+
+			const FVector WeaponTraceStart{SocketTransform.GetLocation()};
+			TArray<FHitResult> PelletHits;
+			for (int32 ShotIndex = 0; ShotIndex < ShotCount; ++ShotIndex)
 			{
-				// Spawn Default particles 
-				if (ImpactParticles)
+				FRandomStream SpreadStream(SpreadSeed + ShotIndex);
+				for (int32 Pellet = 0; Pellet < PelletCount; ++Pellet)
 				{
-					// If Impact Particles Spawn them at beam end location 
-					UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ImpactParticles, BeamHitResult.Location);
+					const FVector WeaponTraceEnd{
+						GetPelletTraceEnd(WeaponTraceStart, BeamEndLocation, EquippedWeapon->GetPelletSpreadAngle(),
+						                  SpreadStream)
+					};
+					FHitResult PelletHit;
+					if (GetWorld()->LineTraceSingleByChannel(PelletHit, WeaponTraceStart, WeaponTraceEnd, ECC_Visibility))
+					{
+						PelletHits.Add(PelletHit);
+					}
 				}
 			}
+			ResolvePelletHits(SocketTransform, PelletHits, EquippedWeapon->GetDamage(),
+			                  EquippedWeapon->GetHeadShotDamage());
+			return;
+		}
 
+		FHitResult BeamHitResult;
+		// Get Beam end Location 
+		bool bBeamEnd = GetBeamEndLocation(SocketTransform.GetLocation(), BeamHitResult);
 
-			// Spawn Beam particles along the X of the socket transform until the BeamEnd location 
-			UParticleSystemComponent* Beam = UGameplayStatics::SpawnEmitterAtLocation(
-				GetWorld(), BeamParticles, SocketTransform);
+		if (bBeamEnd)
+		{
+			ResolveBulletHit(SocketTransform, BeamHitResult, EquippedWeapon->GetDamage(),
+			                 EquippedWeapon->GetHeadShotDamage(), ShotCount);
+		}
+	}
+}
 
-			if (Beam)
-			{
-				Beam->SetVectorParameter(FName("Target"), BeamHitResult.Location);
-			}
+void AShooterCharacter::ResolveBulletHit(const FTransform& SocketTransform, const FHitResult& BeamHitResult,
+                                         float Damage, float HeadShotDamage, int32 ShotCount)
+{
+	ApplyBulletHit(BeamHitResult, Damage, HeadShotDamage, ShotCount);
+
+	SpawnBulletFX(SocketTransform, BeamHitResult);
+}
+
+void AShooterCharacter::ApplyBulletHit(const FHitResult& HitResult, float Damage, float HeadShotDamage,
+                                       int32 ShotCount)
+{
+	// Does Hit Actor implement bulletHitInterface
+	if (!HitResult.Actor.IsValid()) return;
+
+	IBulletHitInterface* BulletHitInterface = Cast<IBulletHitInterface>(HitResult.Actor.Get());
+
+	if (BulletHitInterface)
+	{
+		BulletHitInterface->BulletHit_Implementation(HitResult, this, GetController());
+	}
+
+	AEnemy* HitEnemy = Cast<AEnemy>(HitResult.Actor.Get());
+	if (HitEnemy)
+	{
+		bool bHeadShot = false;
+		const int32 HitDamage{GetBulletHitDamage(HitEnemy, HitResult, Damage, HeadShotDamage, bHeadShot)};
+
+		// The shots of a batch hit the same spot, one damage event and one hit number for all of them
+		const int32 BatchDamage{HitDamage * ShotCount};
+		UDamageQueueSubsystem::QueueDamage(HitResult.Actor.Get(), BatchDamage,
+		                                   GetController(), this, UDamageType::StaticClass());
+
+		HitEnemy->ShowHitNumber(BatchDamage, HitResult.Location, bHeadShot);
+	}
+	AExplosive* HitExplosive = Cast<AExplosive>(HitResult.Actor.Get());
+	if (HitExplosive)
+	{
+		// Every shot of a catch up batch hits the barrel
+		UDamageQueueSubsystem::QueueDamage(HitResult.Actor.Get(), Damage * ShotCount,
+		                                   GetController(), this, UDamageType::StaticClass());
+	}
+}
+
+void AShooterCharacter::ResolveProjectileHit(const FHitResult& HitResult, float Damage, float HeadShotDamage)
+{
+	ApplyBulletHit(HitResult, Damage, HeadShotDamage, 1);
+
+	// No beam, the projectile flew to the hit. Actors hit spawn their own impact
+	UFXPoolSubsystem* FXPool = GetWorld()->GetSubsystem<UFXPoolSubsystem>();
+	if (FXPool && ImpactParticles && !HitResult.Actor.IsValid())
+	{
+		FXPool->SpawnFX(ImpactParticles, HitResult.Location);
+	}
+}
+
+void AShooterCharacter::LaunchProjectiles(const FTransform& SocketTransform, int32 ShotCount, int32 SpreadSeed)
+{
+	UProjectileSubsystem* Projectiles = GetWorld()->GetSubsystem<UProjectileSubsystem>();
+	if (Projectiles == nullptr) return;
+
+	// Aim at the crossHair hit like the barrel trace
+	FHitResult CrossHairHitResult;
+	FVector BeamEndLocation;
+	TraceUnderCrossHair(CrossHairHitResult, BeamEndLocation);
+
+	FProjectileParams Params;
+	Params.GravityScale = EquippedWeapon->GetProjectileGravityScale();
+	Params.Drag = EquippedWeapon->GetProjectileDrag();
+	Params.Lifetime = EquippedWeapon->GetProjectileLifetime();
+	Params.Damage = EquippedWeapon->GetDamage();
+	Params.HeadShotDamage = EquippedWeapon->GetHeadShotDamage();
+
+	const FVector LaunchLocation{SocketTransform.GetLocation()};
+	const int32 PelletCount{EquippedWeapon->GetPelletCount()};
+	for (int32 ShotIndex = 0; ShotIndex < ShotCount; ++ShotIndex)
+	{
+		FRandomStream SpreadStream(SpreadSeed + ShotIndex);
+		for (int32 Pellet = 0; Pellet < PelletCount; ++Pellet)
+		{
+			const FVector AimLocation{
+				PelletCount > 1
+					? GetPelletTraceEnd(LaunchLocation, BeamEndLocation, EquippedWeapon->GetPelletSpreadAngle(),
+					                    SpreadStream)
+					: BeamEndLocation
+			};
+			const FVector LaunchDirection{(AimLocation - LaunchLocation).GetSafeNormal()};
+			Projectiles->LaunchProjectile(this, LaunchLocation, LaunchDirection * EquippedWeapon->GetProjectileSpeed(),
+			                              Params);
+		}
+	}
+}
+
+void AShooterCharacter::ResolvePelletHits(const FTransform& SocketTransform, const TArray<FHitResult>& PelletHits,
+                                          float Damage, float HeadShotDamage)
+{
+	struct FActorPelletDamage
+	{
+		/* First pellet hit on the actor, passed to the bullet hit interface */
+		const FHitResult* HitResult;
+		float Damage;
+		bool bHeadShot;
+	};
+	TMap<AActor*, FActorPelletDamage, TInlineSetAllocator<8>> ActorDamages;
+
+	for (const FHitResult& PelletHit : PelletHits)
+	{
+		SpawnBulletFX(SocketTransform, PelletHit);
+
+		AActor* HitActor = PelletHit.Actor.Get();
+		if (HitActor == nullptr) continue;
+
+		FActorPelletDamage* ActorDamage = ActorDamages.Find(HitActor);
+		if (ActorDamage == nullptr)
+		{
+			ActorDamage = &ActorDamages.Add(HitActor, FActorPelletDamage{&PelletHit, 0.f, false});
+		}
+
+		if (const AEnemy* HitEnemy = Cast<AEnemy>(HitActor))
+		{
+			bool bHeadShot = false;
+			ActorDamage->Damage += GetBulletHitDamage(HitEnemy, PelletHit, Damage, HeadShotDamage, bHeadShot);
+			ActorDamage->bHeadShot |= bHeadShot;
+		}
+		else
+		{
+			ActorDamage->Damage += Damage;
+		}
+	}
+
+	for (const TPair<AActor*, FActorPelletDamage>& ActorDamage : ActorDamages)
+	{
+		AActor* HitActor = ActorDamage.Key;
+		const FActorPelletDamage& PelletDamage = ActorDamage.Value;
+
+		IBulletHitInterface* BulletHitInterface = Cast<IBulletHitInterface>(HitActor);
+		if (BulletHitInterface)
+		{
+			BulletHitInterface->BulletHit_Implementation(*PelletDamage.HitResult, this, GetController());
+		}
+
+		AEnemy* HitEnemy = Cast<AEnemy>(HitActor);
+		if (HitEnemy)
+		{
+			UDamageQueueSubsystem::QueueDamage(HitActor, PelletDamage.Damage, GetController(), this,
+			                                   UDamageType::StaticClass());
+
+			HitEnemy->ShowHitNumber(static_cast<int32>(PelletDamage.Damage), PelletDamage.HitResult->Location,
+			                        PelletDamage.bHeadShot);
+		}
+		if (Cast<AExplosive>(HitActor))
+		{
+			UDamageQueueSubsystem::QueueDamage(HitActor, PelletDamage.Damage, GetController(), this,
+			                                   UDamageType::StaticClass());
+		}
+	}
+}
+
+int32 AShooterCharacter::GetBulletHitDamage(const AEnemy* HitEnemy, const FHitResult& HitResult, float Damage,
+                                            float HeadShotDamage, bool& bOutHeadShot) const
+{
+	const EHitZone HitZone{HitEnemy->GetHitZone(HitResult)};
+
+	// HeadShot or Body Shot
+	bOutHeadShot = HitZone == EHitZone::EHZ_Head;
+	return static_cast<int32>((bOutHeadShot ? HeadShotDamage : Damage) * HitEnemy->GetHitZoneMultiplier(HitZone));
+}
+
+void AShooterCharacter::SpawnBulletFX(const FTransform& SocketTransform, const FHitResult& BeamHitResult)
+{
+	UFXPoolSubsystem* FXPool = GetWorld()->GetSubsystem<UFXPoolSubsystem>();
+	if (FXPool == nullptr) return;
+
+	// Actors hit spawn their own impact through the bullet hit interface
+	if (!BeamHitResult.Actor.IsValid() && ImpactParticles)
+	{
+		// Spawn Default particles at beam end location 
+		FXPool->SpawnFX(ImpactParticles, BeamHitResult.Location);
+	}
+
+	// Spawn Beam particles along the X of the socket transform until the BeamEnd location 
+	UParticleSystemComponent* Beam = FXPool->SpawnFX(BeamParticles, SocketTransform);
+
+	if (Beam)
+	{
+		// Recycled beams already have the Target parameter, this updates it in place
+		static const FName BeamTargetName{TEXT("Target")};
+		Beam->SetVectorParameter(BeamTargetName, BeamHitResult.Location);
+	}
+}
+
+FVector AShooterCharacter::GetWeaponTraceEnd(const FVector& MuzzleSocketEndLocation,
+                                             const FVector& BeamEndLocation) const
+{
+	// Overshoot the beam end so the barrel trace still reaches the surface hit by the crossHair trace
+	const FVector StartToEnd{BeamEndLocation - MuzzleSocketEndLocation};
+	return MuzzleSocketEndLocation + StartToEnd * 1.25f;
+}
+
+FVector AShooterCharacter::GetPelletTraceEnd(const FVector& MuzzleSocketEndLocation, const FVector& BeamEndLocation,
+                                             float SpreadAngle, FRandomStream& SpreadStream) const
+{
+	// Same reach as the barrel trace, in a direction drawn inside the spread cone
+	const FVector StartToEnd{GetWeaponTraceEnd(MuzzleSocketEndLocation, BeamEndLocation) - MuzzleSocketEndLocation};
+	const FVector PelletDirection{
+		SpreadStream.VRandCone(StartToEnd.GetSafeNormal(), FMath::DegreesToRadians(SpreadAngle))
+	};
+	return MuzzleSocketEndLocation + PelletDirection * StartToEnd.Size();
+}
+
+void AShooterCharacter::SubmitBarrelTrace(uint32 ShotId, const FVector& BeamEndLocation)
+{
+	FHitscanShot* Shot = PendingHitscanShots.Find(ShotId);
+	if (Shot == nullptr) return;
+
+	Shot->BeamEndLocation = BeamEndLocation;
+
+	const FVector WeaponTraceStart{Shot->SocketTransform.GetLocation()};
+	if (Shot->PelletCount <= 1)
+	{
+		const FVector WeaponTraceEnd{GetWeaponTraceEnd(WeaponTraceStart, BeamEndLocation)};
+		GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, WeaponTraceStart, WeaponTraceEnd, ECC_Visibility,
+		                                    FCollisionQueryParams::DefaultQueryParam,
+		                                    FCollisionResponseParams::DefaultResponseParam,
+		                                    &BarrelTraceDelegate, ShotId);
+		return;
+	}
+
+	// Every pellet goes in the same async batch under the shot id, the shot resolves when the last one is back
+	Shot->PendingTraces = Shot->ShotCount * Shot->PelletCount;
+	Shot->PelletHits.Reserve(Shot->PendingTraces);
+	for (int32 ShotIndex = 0; ShotIndex < Shot->ShotCount; ++ShotIndex)
+	{
+		FRandomStream SpreadStream(Shot->SpreadSeed + ShotIndex);
+		for (int32 Pellet = 0; Pellet < Shot->PelletCount; ++Pellet)
+		{
+			const FVector WeaponTraceEnd{
+				GetPelletTraceEnd(WeaponTraceStart, BeamEndLocation, Shot->PelletSpreadAngle, SpreadStream)
+			};
+			GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, WeaponTraceStart, WeaponTraceEnd,
+			                                    ECC_Visibility, FCollisionQueryParams::DefaultQueryParam,
+			                                    FCollisionResponseParams::DefaultResponseParam,
+			                                    &BarrelTraceDelegate, ShotId);
+		}
+	}
+}
+
+void AShooterCharacter::OnCrossHairTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	// CrossHair hit is the tentative beam location, otherwise the end of the trace
+	const bool bCrossHairHit = TraceDatum.OutHits.Num() > 0 && TraceDatum.OutHits[0].bBlockingHit;
+	const FVector BeamEndLocation{bCrossHairHit ? TraceDatum.OutHits[0].Location : TraceDatum.End};
+
+	SubmitBarrelTrace(TraceDatum.UserData, BeamEndLocation);
+}
+
+void AShooterCharacter::OnBarrelTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	FHitscanShot* PendingShot = PendingHitscanShots.Find(TraceDatum.UserData);
+	if (PendingShot == nullptr) return;
+
+	const bool bBlockingHit{TraceDatum.OutHits.Num() > 0 && TraceDatum.OutHits[0].bBlockingHit};
+
+	if (PendingShot->PelletCount > 1)
+	{
+		if (bBlockingHit)
+		{
+			PendingShot->PelletHits.Add(TraceDatum.OutHits[0]);
 		}
+		if (--PendingShot->PendingTraces > 0) return;
+
+		FHitscanShot PelletShot;
+		PendingHitscanShots.RemoveAndCopyValue(TraceDatum.UserData, PelletShot);
+		ResolvePelletHits(PelletShot.SocketTransform, PelletShot.PelletHits, PelletShot.Damage,
+		                  PelletShot.HeadShotDamage);
+		return;
 	}
+
+	FHitscanShot Shot;
+	PendingHitscanShots.RemoveAndCopyValue(TraceDatum.UserData, Shot);
+
+	// Same as the blocking path, nothing to resolve when the barrel trace hits nothing
+	if (!bBlockingHit) return;
+
+	ResolveBulletHit(Shot.SocketTransform, TraceDatum.OutHits[0], Shot.Damage, Shot.HeadShotDamage, Shot.ShotCount);
 }
 
 void AShooterCharacter::PlayGunFireMontage()
@@ -778,7 +1141,7 @@ void AShooterCharacter::PlayGunFireMontage()
 	}
 }
 
-bool AShooterCharacter::TraceUnderCrossHair(FHitResult& OutHitResult, FVector& OutHitLocation)
+void AShooterCharacter::ValidateCrossHairCache()
 {
 	//Get Current Size of the view Port 
 	FVector2D ViewPortSize;
@@ -788,98 +1151,165 @@ bool AShooterCharacter::TraceUnderCrossHair(FHitResult& OutHitResult, FVector& O
 		GEngine->GameViewport->GetViewportSize(ViewPortSize);
 	}
 
+	// Deprojection uses the camera manager view, compare against it
+	FVector CameraLocation{FVector::ZeroVector};
+	FRotator CameraRotation{FRotator::ZeroRotator};
+	float CameraFOV{0.f};
+	const APlayerController* PlayerController = UGameplayStatics::GetPlayerController(this, 0);
+	if (PlayerController && PlayerController->PlayerCameraManager)
+	{
+		CameraLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+		CameraRotation = PlayerController->PlayerCameraManager->GetCameraRotation();
+		CameraFOV = PlayerController->PlayerCameraManager->GetFOVAngle();
+	}
+
+	if (CrossHairCache.FrameNumber == GFrameCounter &&
+		CrossHairCache.CameraLocation.Equals(CameraLocation) &&
+		CrossHairCache.CameraRotation.Equals(CameraRotation) &&
+		CrossHairCache.CameraFOV == CameraFOV &&
+		CrossHairCache.ViewPortSize == ViewPortSize)
+	{
+		return;
+	}
+
+	// New frame or the camera moved, the cached ray and hit are stale
+	CrossHairCache.FrameNumber = GFrameCounter;
+	CrossHairCache.CameraLocation = CameraLocation;
+	CrossHairCache.CameraRotation = CameraRotation;
+	CrossHairCache.CameraFOV = CameraFOV;
+	CrossHairCache.ViewPortSize = ViewPortSize;
+	CrossHairCache.bRayCached = false;
+	CrossHairCache.bTraceCached = false;
+}
+
+bool AShooterCharacter::DeprojectCrossHair(FVector& OutWorldPosition, FVector& OutWorldDirection)
+{
+	ValidateCrossHairCache();
+
+	if (CrossHairCache.bRayCached)
+	{
+		INC_DWORD_STAT(STAT_CrossHairRayCacheHits);
+		OutWorldPosition = CrossHairCache.WorldPosition;
+		OutWorldDirection = CrossHairCache.WorldDirection;
+		return CrossHairCache.bRayValid;
+	}
+	INC_DWORD_STAT(STAT_CrossHairRayCacheMisses);
+
 	// Get Screen Space Location of the crossHairs 
+	const FVector2D& ViewPortSize = CrossHairCache.ViewPortSize;
 	FVector2D CrossHairLocation{ViewPortSize.X / 2.f, ViewPortSize.Y / 2};
 
 	//CrossHairLocation.Y -= 50.f;
+
+	//Get World Position and direction of crossHairs
+	CrossHairCache.bRayValid = UGameplayStatics::DeprojectScreenToWorld(
+		UGameplayStatics::GetPlayerController(this, 0),
+		CrossHairLocation,
+		CrossHairCache.WorldPosition, CrossHairCache.WorldDirection);
+	CrossHairCache.bRayCached = true;
+
+	OutWorldPosition = CrossHairCache.WorldPosition;
+	OutWorldDirection = CrossHairCache.WorldDirection;
+	return CrossHairCache.bRayValid;
+}
+
+bool AShooterCharacter::TraceUnderCrossHair(FHitResult& OutHitResult, FVector& OutHitLocation)
+{
+	ValidateCrossHairCache();
+
+	if (CrossHairCache.bTraceCached)
+	{
+		INC_DWORD_STAT(STAT_CrossHairTraceCacheHits);
+		OutHitResult = CrossHairCache.HitResult;
+		OutHitLocation = CrossHairCache.HitLocation;
+		return CrossHairCache.bTraceHit;
+	}
+	INC_DWORD_STAT(STAT_CrossHairTraceCacheMisses);
+
 	FVector CrossHairWorldPosition;
 	FVector CrossHairWorldDirection;
 
-	//Get World Position and direction of crossHairs
-	bool bScreenToWorld = UGameplayStatics::DeprojectScreenToWorld(UGameplayStatics::GetPlayerController(this, 0),
-	                                                               CrossHairLocation,
-	                                                               CrossHairWorldPosition, CrossHairWorldDirection);
+	CrossHairCache.HitResult = FHitResult();
+	CrossHairCache.bTraceHit = false;
 
-	if (bScreenToWorld)
+	if (DeprojectCrossHair(CrossHairWorldPosition, CrossHairWorldDirection))
 	{
 		//Trace from CrossHair world location outward
 		const FVector Start{CrossHairWorldPosition};
 		const FVector End{Start + CrossHairWorldDirection * 50000.f};
-		OutHitLocation = End;
-		GetWorld()->LineTraceSingleByChannel(OutHitResult, Start, End, ECC_Visibility);
+		CrossHairCache.HitLocation = End;
+		GetWorld()->LineTraceSingleByChannel(CrossHairCache.HitResult, Start, End, ECC_Visibility);
 
-		if (OutHitResult.bBlockingHit)
+		if (CrossHairCache.HitResult.bBlockingHit)
 		{
-			OutHitLocation = OutHitResult.Location;
-			return true;
+			CrossHairCache.HitLocation = CrossHairCache.HitResult.Location;
+			CrossHairCache.bTraceHit = true;
 		}
 	}
-	return false;
+	CrossHairCache.bTraceCached = true;
+
+	OutHitResult = CrossHairCache.HitResult;
+	OutHitLocation = CrossHairCache.HitLocation;
+	return CrossHairCache.bTraceHit;
 }
 
 void AShooterCharacter::TraceForItems()
 {
 	if (bShouldTraceForItems)
 	{
-		//Trace under crossHairs
-		FHitResult ItemHitResult;
-		FVector HitLocation;
-		TraceUnderCrossHair(ItemHitResult, HitLocation);
-		if (ItemHitResult.bBlockingHit)
+		//Find the item under crossHairs
+		TraceHitItem = FindItemUnderCrossHair();
+		const auto TraceHitWeapon = Cast<AWeapon>(TraceHitItem);
+		if (TraceHitWeapon)
 		{
-			TraceHitItem = Cast<AItem>(ItemHitResult.Actor);
-			const auto TraceHitWeapon = Cast<AWeapon>(TraceHitItem);
-			if (TraceHitWeapon)
+			if (HighLightedSlot == -1)
 			{
-				if (HighLightedSlot == -1)
-				{
-					//Not Currently Highlighting a slot ; HighLight One
-					HighLightInventorySlot();
-				}
+				//Not Currently Highlighting a slot ; HighLight One
+				HighLightInventorySlot();
 			}
-			else
+		}
+		else
+		{
+			if (HighLightedSlot != -1)
 			{
-				if (HighLightedSlot != -1)
-				{
-					// A slot is being highlighted , UnHighlightInventory slot
-					UnHighLightInventorySlot();
-				}
+				// A slot is being highlighted , UnHighlightInventory slot
+				UnHighLightInventorySlot();
 			}
+		}
 
-			if (TraceHitItem && TraceHitItem->GetItemState() == EItemState::EIS_EquipInterping)
+		if (TraceHitItem && TraceHitItem->GetItemState() == EItemState::EIS_EquipInterping)
+		{
+			TraceHitItem = nullptr;
+		}
+
+		if (TraceHitItem && TraceHitItem->GetPickUpWidget())
+		{
+			//Get hit item and set widget visibility
+			TraceHitItem->GetPickUpWidget()->SetVisibility(true);
+			TraceHitItem->EnableCustomDepth();
+			if (Inventory.Num() >= INVENTORY_CAPACITY)
 			{
-				TraceHitItem = nullptr;
+				// Inventory is full
+				TraceHitItem->SetCharacterInventoryFull(true);
 			}
-
-			if (TraceHitItem && TraceHitItem->GetPickUpWidget())
+			else
 			{
-				//Get hit item and set widget visibility
-				TraceHitItem->GetPickUpWidget()->SetVisibility(true);
-				TraceHitItem->EnableCustomDepth();
-				if (Inventory.Num() >= INVENTORY_CAPACITY)
-				{
-					// Inventory is full
-					TraceHitItem->SetCharacterInventoryFull(true);
-				}
-				else
-				{
-					// Inventory Has room
-					TraceHitItem->SetCharacterInventoryFull(false);
-				}
+				// Inventory Has room
+				TraceHitItem->SetCharacterInventoryFull(false);
 			}
-			//we hit a AItem last frame 
-			if (TraceHitItemLastFrame)
+		}
+		//we hit a AItem last frame 
+		if (TraceHitItemLastFrame)
+		{
+			if (TraceHitItem != TraceHitItemLastFrame)
 			{
-				if (TraceHitItem != TraceHitItemLastFrame)
-				{
-					//Hitting a different item or AItem is null 
-					TraceHitItemLastFrame->GetPickUpWidget()->SetVisibility(false);
-					TraceHitItemLastFrame->DisableCustomDepth();
-				}
+				//Hitting a different item or AItem is null 
+				TraceHitItemLastFrame->GetPickUpWidget()->SetVisibility(false);
+				TraceHitItemLastFrame->DisableCustomDepth();
 			}
-			//Store a reference to hit item for next frame 
-			TraceHitItemLastFrame = TraceHitItem;
 		}
+		//Store a reference to hit item for next frame 
+		TraceHitItemLastFrame = TraceHitItem;
 	}
 	else if (TraceHitItemLastFrame)
 	{
@@ -890,6 +1320,35 @@ void AShooterCharacter::TraceForItems()
 	}
 }
 
+AItem* AShooterCharacter::FindItemUnderCrossHair()
+{
+	UItemRegistrySubsystem* ItemRegistry = GetWorld()->GetSubsystem<UItemRegistrySubsystem>();
+	if (ItemRegistry == nullptr) return nullptr;
+
+	FVector CrossHairWorldPosition;
+	FVector CrossHairWorldDirection;
+	if (!DeprojectCrossHair(CrossHairWorldPosition, CrossHairWorldDirection)) return nullptr;
+
+	AItem* BestItem = ItemRegistry->FindBestItemInCone(GetActorLocation(), ItemQueryRadius, CrossHairWorldPosition,
+	                                                   CrossHairWorldDirection, ItemQueryAngle);
+
+	if (BestItem && bConfirmItemTrace)
+	{
+		// Only the best candidate is traced, make sure nothing stands between the camera and the item
+		FHitResult ConfirmHitResult;
+		FCollisionQueryParams QueryParams;
+		QueryParams.AddIgnoredActor(this);
+		GetWorld()->LineTraceSingleByChannel(ConfirmHitResult, CrossHairWorldPosition,
+		                                     UItemRegistrySubsystem::GetItemQueryLocation(BestItem), ECC_Visibility,
+		                                     QueryParams);
+		if (ConfirmHitResult.bBlockingHit && ConfirmHitResult.Actor != BestItem)
+		{
+			return nullptr;
+		}
+	}
+	return BestItem;
+}
+
 AWeapon* AShooterCharacter::SpawnDefaultWeapon()
 {
 	//Check subclass of variable 
@@ -925,6 +1384,14 @@ void AShooterCharacter::EquipWeapon(AWeapon* WeaponToEquip, bool bSwapping)
 		// Set Equipped item to the newly spawned weapon 
 		EquippedWeapon = WeaponToEquip;
 		EquippedWeapon->SetItemState(EItemState::EIS_Equipped);
+
+		// Have the weapon effects ready before the first shot
+		if (UFXPoolSubsystem* FXPool = GetWorld()->GetSubsystem<UFXPoolSubsystem>())
+		{
+			FXPool->Prewarm(EquippedWeapon->GetMuzzleFlash(), EquippedWeapon->GetFXPoolSize());
+			FXPool->Prewarm(BeamParticles, EquippedWeapon->GetFXPoolSize());
+			FXPool->Prewarm(ImpactParticles, EquippedWeapon->GetFXPoolSize());
+		}
 	}
 }
 
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "AmmoType.h"
+#include "WorldCollision.h"
 #include "ShooterCharacter.generated.h"
 
 
@@ -40,6 +41,55 @@ struct FInterpLocation
 	int32 ItemCount;
 };
 
+/* A shot waiting on its async hitscan traces */
+struct FHitscanShot
+{
+	/* Barrel socket transform at the time the shot was fired */
+	FTransform SocketTransform;
+
+	/* Weapon damage values captured when firing, the weapon may be swapped before the shot resolves */
+	float Damage;
+	float HeadShotDamage;
+
+	/* End of the crosshair trace, used as beam end when the barrel trace hits nothing */
+	FVector BeamEndLocation;
+
+	/* Shots fired in the same frame share the traces and resolve together */
+	int32 ShotCount;
+
+	/* Pellets of each shot, their spread cone half angle in degrees and the spread seed of the first shot */
+	int32 PelletCount;
+	float PelletSpreadAngle;
+	int32 SpreadSeed;
+
+	/* Pellet traces still in flight and the blocking hits of those already back */
+	int32 PendingTraces;
+	TArray<FHitResult> PelletHits;
+};
+
+/* CrossHair ray and trace shared by everything that traces under the crossHairs during a frame */
+struct FCrossHairCache
+{
+	/* Frame and camera view the cached values were computed for */
+	uint64 FrameNumber = 0;
+	FVector CameraLocation = FVector::ZeroVector;
+	FRotator CameraRotation = FRotator::ZeroRotator;
+	float CameraFOV = 0.f;
+	FVector2D ViewPortSize = FVector2D::ZeroVector;
+
+	/* Deprojected crossHair ray */
+	bool bRayCached = false;
+	bool bRayValid = false;
+	FVector WorldPosition = FVector::ZeroVector;
+	FVector WorldDirection = FVector::ZeroVector;
+
+	/* Result of the trace along the crossHair ray */
+	bool bTraceCached = false;
+	bool bTraceHit = false;
+	FHitResult HitResult;
+	FVector HitLocation = FVector::ZeroVector;
+};
+
 #pragma endregion
 
 #pragma region Delegates
@@ -78,6 +128,10 @@ public:
 private:
 #pragma  region private Components for ShooterCharacter
 
+	/** Fire, crossHair and item sound cooldowns */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Combat", meta=(AllowPrivateAccess="true"))
+	class UCooldownComponent* Cooldowns;
+
 	/* Camera Components  */
 #pragma  region  Camera
 
@@ -172,20 +226,39 @@ private:
 
 	float ShootTimeDuration;
 
-	bool bFiringBullet;
-
 	//Left Mouse button or right console trigger pressed 
 	bool bFireButtonPressed;
 
 	//True When we can fire false when waiting for timer 
 	bool bShouldFire;
 
-	//Set a timer between gun shots 
-	FTimerHandle AutoFireTimer;
-
 	//True if we should trace for every frame for items 
 	bool bShouldTraceForItems;
 
+	/** True to submit bullet traces asynchronously and resolve the hit next frame, false for the blocking traces */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat", meta=(AllowPrivateAccess="true"))
+	bool bAsyncHitscan;
+
+	//Receive the async crossHair and barrel trace results
+	FTraceDelegate CrossHairTraceDelegate;
+	FTraceDelegate BarrelTraceDelegate;
+
+	//Shots with async traces in flight, keyed by the trace user data
+	TMap<uint32, FHitscanShot> PendingHitscanShots;
+
+	//Id given to the next async shot
+	uint32 NextHitscanShotId;
+
+	/** Most automatic shots fired in one frame, the rest of a longer hitch is dropped */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Combat", meta=(AllowPrivateAccess="true"))
+	int32 MaxAutoFireShotsPerFrame;
+
+	/** Pellet spread seed of the next shot, each shot draws its pellets from its own seed so it can be replayed */
+	int32 NextSpreadSeed;
+
+	//CrossHair ray and hit reused by every trace under the crossHairs in the same frame
+	FCrossHairCache CrossHairCache;
+
 #pragma endregion
 
 	/* CrossHairs Components  */
@@ -211,8 +284,6 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="CrossHairs", meta=(AllowPrivateAccess="true"))
 	float CrossHairShootingFactor;
 
-	FTimerHandle CrossHairShootTimer;
-
 #pragma  endregion
 
 	/* PickUp Widget Components  */
@@ -221,6 +292,18 @@ private:
 	//Number of overlapped AItems 
 	int8 OverlappedItemCount;
 
+	/** Radius around the character searched in the item registry for the item under the crossHairs */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Items", meta=(AllowPrivateAccess="true"))
+	float ItemQueryRadius;
+
+	/** Max angle in degrees between the crossHair ray and an item for it to be highlighted */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Items", meta=(AllowPrivateAccess="true"))
+	float ItemQueryAngle;
+
+	/** True to confirm the best item with a visibility trace so items behind walls are not highlighted */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Items", meta=(AllowPrivateAccess="true"))
+	bool bConfirmItemTrace;
+
 	//The AItem We hit last frame 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Items", meta=(AllowPrivateAccess="true"))
 	class AItem* TraceHitItemLastFrame;
@@ -286,18 +369,6 @@ private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Items", meta=(AllowPrivateAccess="true"))
 	TArray<FInterpLocation> InterpLocations;
 
-	FTimerHandle PickUpSoundTimer;
-
-	FTimerHandle EquipSoundTimer;
-
-	bool bShouldPlayPickUpSound;
-
-	bool bShouldPlayEquipSound;
-
-	void ResetPickUpSoundTimer();
-
-	void ResetEquipSoundTimer();
-
 	/** time to wait before we can play another pickup sound    */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Items", meta=(AllowPrivateAccess="true"))
 	float PickUpSoundResetTime;
@@ -505,12 +576,14 @@ public:
 
 	int32 GetInterpLocationIndex();
 
-	FORCEINLINE bool ShouldPlayPickUpSound() const { return bShouldPlayPickUpSound; }
+	bool ShouldPlayPickUpSound() const;
 
-	FORCEINLINE bool ShouldPlayEquipSound() const { return bShouldPlayEquipSound; }
+	bool ShouldPlayEquipSound() const;
 
 	FORCEINLINE AWeapon* GetEquippedWeapon() const { return EquippedWeapon; }
 
+	FORCEINLINE const TArray<AItem*>& GetInventory() const { return Inventory; }
+
 	FORCEINLINE USoundCue* GetMeleeImpactCue() const { return MeleeImpactCue; }
 
 	FORCEINLINE UParticleSystem* GetBloodParticles() const { return BloodParticles; }
@@ -529,14 +602,17 @@ public:
 
 	void IncrementInterpLocItemCount(int32 Index, int32 Amount);
 
-	void StartPickUpSoundTimer();
+	void StartPickUpSoundCooldown();
 
-	void StartEquipSoundTimer();
+	void StartEquipSoundCooldown();
 
 	void UnHighLightInventorySlot();
 
 	void Stun();
 
+	/** Damage and hit interface of a projectile hit, the projectile subsystem calls it for the projectiles we fired */
+	void ResolveProjectileHit(const FHitResult& HitResult, float Damage, float HeadShotDamage);
+
 	void SetHealth(float ShooterHealth)
 	{
 		Health = ShooterHealth;
@@ -583,6 +659,12 @@ protected:
 	/** Called when the FireButton Is Pressed*/
 	void FireWeapon();
 
+	/** Fire ShotCount shots, the first at FirstShotTime and the others one fire rate apart */
+	void FireShots(int32 ShotCount, float FirstShotTime);
+
+	/** Fire every automatic shot due since the last one, or reset the fire state */
+	void UpdateAutoFire();
+
 	/** The Hit Location for the Beam */
 	bool GetBeamEndLocation(const FVector& MuzzleSocketEndLocation, FHitResult& OutHitResult);
 
@@ -592,8 +674,8 @@ protected:
 	/** Called when Fire Button is Released */
 	void FireButtonReleased();
 
-	/** The Time We started Firing  */
-	void StartFireTimer();
+	/** The Time We started Firing, from the last shot so the fire rate does not drift with the frame time */
+	void StartFireTimer(float LastShotTime);
 
 	/** Called to Reset Fire Timer   */
 	UFUNCTION()
@@ -601,7 +683,45 @@ protected:
 
 	void PlayFireSound();
 
-	void SendBullet();
+	/** Trace once for ShotCount shots fired in the same frame */
+	void SendBullet(int32 ShotCount);
+
+	/** Apply damage for each of ShotCount shots whose barrel trace hit something, hit interface and effects once */
+	void ResolveBulletHit(const FTransform& SocketTransform, const FHitResult& BeamHitResult, float Damage,
+	                      float HeadShotDamage, int32 ShotCount = 1);
+
+	/** Hit interface once and damage for each of ShotCount bullets, no effects */
+	void ApplyBulletHit(const FHitResult& HitResult, float Damage, float HeadShotDamage, int32 ShotCount);
+
+	/** Hand ShotCount shots of a projectile weapon to the projectile subsystem, aimed at the crossHairs */
+	void LaunchProjectiles(const FTransform& SocketTransform, int32 ShotCount, int32 SpreadSeed);
+
+	/** Sum the pellet damage per actor hit, every actor takes one damage event and shows one hit number */
+	void ResolvePelletHits(const FTransform& SocketTransform, const TArray<FHitResult>& PelletHits, float Damage,
+	                       float HeadShotDamage);
+
+	/** Damage of a bullet for the hit zone of the enemy */
+	int32 GetBulletHitDamage(const class AEnemy* HitEnemy, const FHitResult& HitResult, float Damage, float HeadShotDamage,
+	                         bool& bOutHeadShot) const;
+
+	/** Beam toward the hit, and the default impact when no actor was hit */
+	void SpawnBulletFX(const FTransform& SocketTransform, const FHitResult& BeamHitResult);
+
+	/** End point of the trace from the barrel toward the beam end location */
+	FVector GetWeaponTraceEnd(const FVector& MuzzleSocketEndLocation, const FVector& BeamEndLocation) const;
+
+	/** End point of a pellet trace, drawn from the spread stream in the cone around the barrel trace */
+	FVector GetPelletTraceEnd(const FVector& MuzzleSocketEndLocation, const FVector& BeamEndLocation,
+	                          float SpreadAngle, FRandomStream& SpreadStream) const;
+
+	/** Queue the async barrel trace of a pending shot */
+	void SubmitBarrelTrace(uint32 ShotId, const FVector& BeamEndLocation);
+
+	/** Called when the async crossHair trace of a shot is done */
+	void OnCrossHairTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	/** Called when the async barrel trace of a shot is done */
+	void OnBarrelTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
 
 	void PlayGunFireMontage();
 
@@ -629,16 +749,21 @@ protected:
 	// The Spread of the CrossHairs -top -down -right -left 
 	void CalculateCrossHairsSpread(float DeltaTime);
 
-	// Called When Firing Starts 
-	void StartCrossHairBulletFire();
-
-	// Called when Firing Finishes
-	UFUNCTION()
-	void FinishCrossHairBulletFire();
+	// Called When Firing Starts, from the last shot fired 
+	void StartCrossHairBulletFire(float LastShotTime);
 
 	/**  Line trace for items under the crossHairs */
 	bool TraceUnderCrossHair(FHitResult& OutHitResult, FVector& OutHitLocation);
 
+	/** World position and direction of the crossHairs */
+	bool DeprojectCrossHair(FVector& OutWorldPosition, FVector& OutWorldDirection);
+
+	/** Drop the crossHair cache when the frame or the camera view changed since it was filled */
+	void ValidateCrossHairCache();
+
+	/** Item in the PickUp state closest to the crossHair ray, found in the item registry */
+	AItem* FindItemUnderCrossHair();
+
 #pragma  endregion
 
 	/* PickUp Widget Functions */
@@ -0,0 +1,129 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ShooterDataSubsystem.h"
+
+#include "Weapon.h"
+#include "Engine/DataTable.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+namespace
+{
+	const TCHAR* WeaponTablePath{TEXT("DataTable'/Game/_Game/DataTables/WeaponDataTable.WeaponDataTable'")};
+	const TCHAR* RarityTablePath{TEXT("DataTable'/Game/_Game/DataTables/ItemRarityDataTable.ItemRarityDataTable'")};
+
+	/**
+	 * Row name for each EWeaponType. WeaponDataTable has no Shotgun row yet, until the row is added
+	 * in content the shotgun type has no definition and its weapons keep their class defaults
+	 */
+	const TCHAR* WeaponRowNames[] = {TEXT("SubmachineGun"), TEXT("AssaultRifle"), TEXT("Pistol"), TEXT("Shotgun")};
+
+	/** Row name for each EItemRarity */
+	const TCHAR* RarityRowNames[] = {TEXT("Damaged"), TEXT("Common"), TEXT("UnCommon"), TEXT("Rare"), TEXT("Legendary")};
+
+	static_assert(UE_ARRAY_COUNT(WeaponRowNames) == static_cast<uint8>(EWeaponType::EWT_MAX),
+		"Every weapon type needs a row name");
+	static_assert(UE_ARRAY_COUNT(RarityRowNames) == static_cast<uint8>(EItemRarity::EIR_Max),
+		"Every item rarity needs a row name");
+}
+
+void UShooterDataSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	LoadTables();
+}
+
+void UShooterDataSubsystem::Deinitialize()
+{
+	if (WeaponTable)
+	{
+		WeaponTable->OnDataTableChanged().RemoveAll(this);
+	}
+	if (RarityTable)
+	{
+		RarityTable->OnDataTableChanged().RemoveAll(this);
+	}
+	FMemory::Memzero(WeaponDefinitions);
+	FMemory::Memzero(RarityDefinitions);
+	WeaponTable = nullptr;
+	RarityTable = nullptr;
+	bTablesLoaded = false;
+
+	Super::Deinitialize();
+}
+
+UShooterDataSubsystem* UShooterDataSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	if (GameInstance)
+	{
+		if (UShooterDataSubsystem* Subsystem = GameInstance->GetSubsystem<UShooterDataSubsystem>())
+		{
+			return Subsystem;
+		}
+	}
+
+	// No game instance yet, the class default object keeps its own copy of the tables
+	UShooterDataSubsystem* DefaultSubsystem = GetMutableDefault<UShooterDataSubsystem>();
+	DefaultSubsystem->LoadTables();
+	return DefaultSubsystem;
+}
+
+const FWeaponDataTable* UShooterDataSubsystem::GetWeaponDefinition(const UObject* WorldContextObject,
+                                                                   EWeaponType WeaponType)
+{
+	return Get(WorldContextObject)->GetWeaponDefinition(WeaponType);
+}
+
+const FItemRarityTable* UShooterDataSubsystem::GetRarityDefinition(const UObject* WorldContextObject,
+                                                                   EItemRarity Rarity)
+{
+	return Get(WorldContextObject)->GetRarityDefinition(Rarity);
+}
+
+void UShooterDataSubsystem::LoadTables()
+{
+	if (bTablesLoaded) return;
+	bTablesLoaded = true;
+
+	WeaponTable = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, WeaponTablePath));
+	if (WeaponTable)
+	{
+		WeaponTable->OnDataTableChanged().AddUObject(this, &UShooterDataSubsystem::ResolveRows);
+	}
+
+	RarityTable = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, RarityTablePath));
+	if (RarityTable)
+	{
+		RarityTable->OnDataTableChanged().AddUObject(this, &UShooterDataSubsystem::ResolveRows);
+	}
+
+	ResolveRows();
+}
+
+void UShooterDataSubsystem::ResolveRows()
+{
+	FMemory::Memzero(WeaponDefinitions);
+	FMemory::Memzero(RarityDefinitions);
+
+	if (WeaponTable)
+	{
+		for (uint8 Type = 0; Type < static_cast<uint8>(EWeaponType::EWT_MAX); ++Type)
+		{
+			// A missing row is expected content, not an error to log on every resolve
+			WeaponDefinitions[Type] = WeaponTable->FindRow<FWeaponDataTable>(FName(WeaponRowNames[Type]), TEXT(""),
+			                                                                 false);
+		}
+	}
+
+	if (RarityTable)
+	{
+		for (uint8 Rarity = 0; Rarity < static_cast<uint8>(EItemRarity::EIR_Max); ++Rarity)
+		{
+			RarityDefinitions[Rarity] = RarityTable->FindRow<FItemRarityTable>(FName(RarityRowNames[Rarity]), TEXT(""));
+		}
+	}
+}
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Item.h"
+#include "WeaponType.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "ShooterDataSubsystem.generated.h"
+
+struct FWeaponDataTable;
+
+/**
+ * Loads the weapon and item rarity data tables once and keeps their rows
+ * indexed by weapon type and item rarity. The rows are resolved again
+ * whenever a table changes, e.g. a reimport or a row edit in the editor
+ */
+UCLASS()
+class SHOOTER_API UShooterDataSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	/**
+	 * Subsystem of the game instance of the context, or the class default object
+	 * when there is none, e.g. OnConstruction in the editor
+	 */
+	static UShooterDataSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Weapon data table row for the weapon type, null if missing */
+	static const FWeaponDataTable* GetWeaponDefinition(const UObject* WorldContextObject, EWeaponType WeaponType);
+
+	/** Item rarity data table row for the rarity, null if missing */
+	static const FItemRarityTable* GetRarityDefinition(const UObject* WorldContextObject, EItemRarity Rarity);
+
+	FORCEINLINE const FWeaponDataTable* GetWeaponDefinition(EWeaponType WeaponType) const
+	{
+		return WeaponDefinitions[static_cast<uint8>(WeaponType)];
+	}
+
+	FORCEINLINE const FItemRarityTable* GetRarityDefinition(EItemRarity Rarity) const
+	{
+		return RarityDefinitions[static_cast<uint8>(Rarity)];
+	}
+
+private:
+	/** Load both tables and resolve their rows, does nothing once loaded */
+	void LoadTables();
+
+	/** Look the rows up again, the old row pointers dangle once a table changed */
+	void ResolveRows();
+
+	UPROPERTY()
+	UDataTable* WeaponTable;
+
+	UPROPERTY()
+	UDataTable* RarityTable;
+
+	/** Rows by weapon type and by item rarity, the MAX entry is always null */
+	const FWeaponDataTable* WeaponDefinitions[static_cast<uint8>(EWeaponType::EWT_MAX) + 1] = {};
+	const FItemRarityTable* RarityDefinitions[static_cast<uint8>(EItemRarity::EIR_Max) + 1] = {};
+
+	bool bTablesLoaded = false;
+};
@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstanceProxy.h"
+
+/**
+ * Animation proxy that splits the update of AnimInstanceType in two:
+ * SnapshotGameThreadState copies what it needs from the owner on the game thread,
+ * NativeThreadSafeUpdateAnimation derives the properties from that copy on the animation worker.
+ * The anim instance must not touch other objects in NativeThreadSafeUpdateAnimation
+ */
+template <typename AnimInstanceType>
+struct TThreadSafeAnimInstanceProxy : public FAnimInstanceProxy
+{
+	explicit TThreadSafeAnimInstanceProxy(UAnimInstance* InAnimInstance):
+		FAnimInstanceProxy(InAnimInstance),
+		AnimInstance(CastChecked<AnimInstanceType>(InAnimInstance))
+	{
+	}
+
+protected:
+	virtual void PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds) override
+	{
+		FAnimInstanceProxy::PreUpdate(InAnimInstance, DeltaSeconds);
+		AnimInstance->SnapshotGameThreadState(DeltaSeconds);
+	}
+
+	virtual void Update(float DeltaSeconds) override
+	{
+		FAnimInstanceProxy::Update(DeltaSeconds);
+		AnimInstance->NativeThreadSafeUpdateAnimation(DeltaSeconds);
+	}
+
+private:
+	AnimInstanceType* AnimInstance;
+};
@@ -3,6 +3,29 @@
 
 #include "Weapon.h"
 
+#include "CooldownComponent.h"
+#include "ShooterDataSubsystem.h"
+#include "WeaponStreamingSubsystem.h"
+#include "Sound/SoundCue.h"
+
+void FWeaponDataTable::GetAssetPaths(TArray<FSoftObjectPath>& OutPaths) const
+{
+	const FSoftObjectPath AssetPaths[] = {
+		PickUpSound.ToSoftObjectPath(), EquipSound.ToSoftObjectPath(), ItemMesh.ToSoftObjectPath(),
+		InventoryIcon.ToSoftObjectPath(), AmmoIcon.ToSoftObjectPath(), MaterialInstance.ToSoftObjectPath(),
+		AnimBP.ToSoftObjectPath(), CrossHairsMiddle.ToSoftObjectPath(), CrossHairsLeft.ToSoftObjectPath(),
+		CrossHairsRight.ToSoftObjectPath(), CrossHairsBottom.ToSoftObjectPath(), CrossHairsTop.ToSoftObjectPath(),
+		MuzzleFlash.ToSoftObjectPath(), FireSound.ToSoftObjectPath()
+	};
+	for (const FSoftObjectPath& AssetPath : AssetPaths)
+	{
+		if (AssetPath.IsValid())
+		{
+			OutPaths.AddUnique(AssetPath);
+		}
+	}
+}
+
 AWeapon::AWeapon():
 	ThrowWeaponTime(0.7f),
 	bFalling(false),
@@ -17,9 +40,19 @@ AWeapon::AWeapon():
 	bMovingSlide(false),
 	MaxSlideDisplacement(4.f),
 	MaxRecoilRotation(20.f),
-	bAutomatic(true)
+	bAutomatic(true),
+	FXPoolSize(8),
+	PelletCount(1),
+	PelletSpreadAngle(0.f),
+	ProjectileSpeed(0.f),
+	ProjectileGravityScale(1.f),
+	ProjectileDrag(0.f),
+	ProjectileLifetime(5.f),
+	bWeaponAssetsApplied(false)
 {
 	PrimaryActorTick.bCanEverTick = true;
+
+	Cooldowns = CreateDefaultSubobject<UCooldownComponent>(TEXT("Cooldowns"));
 }
 
 void AWeapon::Tick(float DeltaSeconds)
@@ -58,6 +91,7 @@ void AWeapon::ThrowWeapon()
 
 	bFalling = true;
 	GetWorldTimerManager().SetTimer(ThrowWeaponTimer, this, &AWeapon::StropFalling, ThrowWeaponTime);
+	UpdateTickEnabled();
 
 	EnableGlowMaterial();
 }
@@ -88,19 +122,35 @@ bool AWeapon::ClipIsFull()
 void AWeapon::StartSlideTimer()
 {
 	bMovingSlide = true;
-	GetWorldTimerManager().SetTimer(SlideTimer, this, &AWeapon::FinishMovingSlide, SlideDisplacementTime);
+	Cooldowns->StartCooldown(ECooldown::ECD_Slide, SlideDisplacementTime);
+	UpdateTickEnabled();
 }
 
 void AWeapon::FinishMovingSlide()
 {
 	bMovingSlide = false;
+	UpdateTickEnabled();
+}
+
+bool AWeapon::HasTickWork() const
+{
+	return Super::HasTickWork() || (GetItemState() == EItemState::EIS_Falling && bFalling) || bMovingSlide;
 }
 
 void AWeapon::UpdateSlideDisplacement()
 {
-	if (SlideDisplacementCurve && bMovingSlide)
+	if (!bMovingSlide) return;
+
+	// Slide time over, stops the tick again
+	if (Cooldowns->IsReady(ECooldown::ECD_Slide))
 	{
-		const float ElapsedTime{GetWorldTimerManager().GetTimerElapsed(SlideTimer)};
+		FinishMovingSlide();
+		return;
+	}
+
+	if (SlideDisplacementCurve)
+	{
+		const float ElapsedTime{Cooldowns->GetElapsed(ECooldown::ECD_Slide)};
 		const float CurveValue{SlideDisplacementCurve->GetFloatValue(ElapsedTime)};
 
 		SlideDisplacement = CurveValue * MaxSlideDisplacement;
@@ -119,70 +169,116 @@ void AWeapon::OnConstruction(const FTransform& Transform)
 {
 	Super::OnConstruction(Transform);
 
-	const FString WeaponTablePath{TEXT("DataTable'/Game/_Game/DataTables/WeaponDataTable.WeaponDataTable'")};
+	// Get the weapon row from the cached data tables
+	const FWeaponDataTable* WeaponDataRow = UShooterDataSubsystem::GetWeaponDefinition(this, WeaponType);
 
-	UDataTable* WeaponTableObject = Cast<UDataTable>(
-		StaticLoadObject(UDataTable::StaticClass(), nullptr, *WeaponTablePath));
+	if (WeaponDataRow)
+	{
+		AmmoType = WeaponDataRow->AmmoType;
+		Ammo = WeaponDataRow->WeaponAmmo;
+		MagazineCapacity = WeaponDataRow->MagazineCapacity;
+		SetItemName(WeaponDataRow->ItemName);
+		SetClipBoneName(WeaponDataRow->ClipBoneName);
+		SetReloadMontageSection(WeaponDataRow->ReloadMontageSection);
+		AutoFireRate = WeaponDataRow->AutoFireRate;
+		BoneToHide = WeaponDataRow->BoneToHide;
+		bAutomatic = WeaponDataRow->bAutomatic;
+		Damage = WeaponDataRow->Damage;
+		HeadShotDamage = WeaponDataRow->HeadShotDamage;
+		FXPoolSize = WeaponDataRow->FXPoolSize;
+		PelletCount = FMath::Max(WeaponDataRow->PelletCount, 1);
+		PelletSpreadAngle = WeaponDataRow->PelletSpreadAngle;
+		ProjectileSpeed = WeaponDataRow->ProjectileSpeed;
+		ProjectileGravityScale = WeaponDataRow->ProjectileGravityScale;
+		ProjectileDrag = WeaponDataRow->ProjectileDrag;
+		ProjectileLifetime = WeaponDataRow->ProjectileLifetime;
+	}
 
-	if (WeaponTableObject)
+	// The editor previews the weapon right away, a game world streams the assets in first
+	if (!GetWorld()->IsGameWorld())
 	{
-		FWeaponDataTable* WeaponDataRow = nullptr;
-		switch (WeaponType)
-		{
-		case EWeaponType::EWT_SubmachineGun:
-			WeaponDataRow = WeaponTableObject->FindRow<FWeaponDataTable>(FName("SubmachineGun"),TEXT(""));
-			break;
-		case EWeaponType::EWT_AssaultRifle:
-			WeaponDataRow = WeaponTableObject->FindRow<FWeaponDataTable>(FName("AssaultRifle"),TEXT(""));
-			break;
-		case EWeaponType::EWT_Pistol:
-			WeaponDataRow = WeaponTableObject->FindRow<FWeaponDataTable>(FName("Pistol"),TEXT(""));
-			break;
-		default:
-			WeaponDataRow = nullptr;
-			break;
-		}
+		ApplyWeaponAssets();
+	}
+}
 
-		if (WeaponDataRow)
-		{
-			AmmoType = WeaponDataRow->AmmoType;
-			Ammo = WeaponDataRow->WeaponAmmo;
-			MagazineCapacity = WeaponDataRow->MagazineCapacity;
-			SetPickUpSound(WeaponDataRow->PickUpSound);
-			SetEquipSound(WeaponDataRow->EquipSound);
-			GetItemSkeletalMesh()->SetSkeletalMesh(WeaponDataRow->ItemMesh);
-			SetItemName(WeaponDataRow->ItemName);
-			SetAmmoIcon(WeaponDataRow->AmmoIcon);
-			SetIconItem(WeaponDataRow->InventoryIcon);
-			SetMaterialInstance(WeaponDataRow->MaterialInstance);
-			PreviousMaterialIndex = GetMaterialIndex();
-			GetItemSkeletalMesh()->SetMaterial(PreviousMaterialIndex, nullptr);
-			SetMaterialIndex(WeaponDataRow->MaterialIndex);
-			SetClipBoneName(WeaponDataRow->ClipBoneName);
-			SetReloadMontageSection(WeaponDataRow->ReloadMontageSection);
-			GetItemSkeletalMesh()->SetAnimInstanceClass(WeaponDataRow->AnimBP);
-			CrossHairsMiddle = WeaponDataRow->CrossHairsMiddle;
-			CrossHairsLeft = WeaponDataRow->CrossHairsLeft;
-			CrossHairsRight = WeaponDataRow->CrossHairsRight;
-			CrossHairsTop = WeaponDataRow->CrossHairsTop;
-			CrossHairsBottom = WeaponDataRow->CrossHairsBottom;
-			AutoFireRate = WeaponDataRow->AutoFireRate;
-			MuzzleFlash = WeaponDataRow->MuzzleFlash;
-			FireSound = WeaponDataRow->FireSound;
-			BoneToHide = WeaponDataRow->BoneToHide;
-			bAutomatic = WeaponDataRow->bAutomatic;
-			Damage = WeaponDataRow->Damage;
-			HeadShotDamage = WeaponDataRow->HeadShotDamage;
-		}
+void AWeapon::ApplyWeaponAssets()
+{
+	bWeaponAssetsApplied = true;
+
+	const FWeaponDataTable* WeaponDataRow = UShooterDataSubsystem::GetWeaponDefinition(this, WeaponType);
+	if (WeaponDataRow == nullptr) return;
+
+	SetPickUpSound(UWeaponStreamingSubsystem::ResolveAsset(WeaponDataRow->PickUpSound));
+	SetEquipSound(UWeaponStreamingSubsystem::ResolveAsset(WeaponDataRow->EquipSound));
+	GetItemSkeletalMesh()->SetSkeletalMesh(UWeaponStreamingSubsystem::ResolveAsset(WeaponDataRow->ItemMesh));
+	SetAmmoIcon(UWeaponStreamingSubsystem::ResolveAsset(WeaponDataRow->AmmoIcon));
+	SetIconItem(UWeaponStreamingSubsystem::ResolveAsset(WeaponDataRow->InventoryIcon));
+	SetMaterialInstance(UWeaponStreamingSubsystem::ResolveAsset(WeaponDataRow->MaterialInstance));
+	PreviousMaterialIndex = GetMaterialIndex();
+	GetItemSkeletalMesh()->SetMaterial(PreviousMaterialIndex, nullptr);
+	SetMaterialIndex(WeaponDataRow->MaterialIndex);
+	GetItemSkeletalMesh()->SetAnimInstanceClass(UWeaponStreamingSubsystem::ResolveClass(WeaponDataRow->AnimBP));
+	CrossHairsMiddle = UWeaponStreamingSubsystem::ResolveAsset(WeaponDataRow->CrossHairsMiddle);
+	CrossHairsLeft = UWeaponStreamingSubsystem::ResolveAsset(WeaponDataRow->CrossHairsLeft);
+	CrossHairsRight = UWeaponStreamingSubsystem::ResolveAsset(WeaponDataRow->CrossHairsRight);
+	CrossHairsTop = UWeaponStreamingSubsystem::ResolveAsset(WeaponDataRow->CrossHairsTop);
+	CrossHairsBottom = UWeaponStreamingSubsystem::ResolveAsset(WeaponDataRow->CrossHairsBottom);
+	MuzzleFlash = UWeaponStreamingSubsystem::ResolveAsset(WeaponDataRow->MuzzleFlash);
+	FireSound = UWeaponStreamingSubsystem::ResolveAsset(WeaponDataRow->FireSound);
 
-		if (GetMaterialInstance())
+	if (GetMaterialInstance())
+	{
+		SetDynamicMaterialInstance(UMaterialInstanceDynamic::Create(GetMaterialInstance(), this));
+		GetDynamicMaterialInstance()->SetVectorParameterValue(TEXT("FresnelColor"), GetGlowColor());
+		GetItemSkeletalMesh()->SetMaterial(GetMaterialIndex(), GetDynamicMaterialInstance());
+		EnableGlowMaterial();
+	}
+
+	// Streamed in after BeginPlay, redo what BeginPlay did with the missing mesh and material
+	if (HasActorBegunPlay())
+	{
+		if (BoneToHide != FName(""))
 		{
-			SetDynamicMaterialInstance(UMaterialInstanceDynamic::Create(GetMaterialInstance(), this));
-			GetDynamicMaterialInstance()->SetVectorParameterValue(TEXT("FresnelColor"), GetGlowColor());
-			GetItemSkeletalMesh()->SetMaterial(GetMaterialIndex(), GetDynamicMaterialInstance());
-			EnableGlowMaterial();
+			GetItemSkeletalMesh()->HideBoneByName(BoneToHide, PBO_None);
 		}
+		ApplyPulseMode();
+		UpdateTickEnabled();
+	}
+}
+
+void AWeapon::ReleaseWeaponAssets()
+{
+	bWeaponAssetsApplied = false;
+
+	GetItemSkeletalMesh()->SetMaterial(GetMaterialIndex(), nullptr);
+	GetItemSkeletalMesh()->SetAnimInstanceClass(nullptr);
+	GetItemSkeletalMesh()->SetSkeletalMesh(nullptr);
+	SetDynamicMaterialInstance(nullptr);
+	SetMaterialInstance(nullptr);
+	SetPickUpSound(nullptr);
+	SetEquipSound(nullptr);
+	SetAmmoIcon(nullptr);
+	SetIconItem(nullptr);
+	CrossHairsMiddle = nullptr;
+	CrossHairsLeft = nullptr;
+	CrossHairsRight = nullptr;
+	CrossHairsTop = nullptr;
+	CrossHairsBottom = nullptr;
+	MuzzleFlash = nullptr;
+	FireSound = nullptr;
+
+	// Nothing left to pulse
+	UpdateTickEnabled();
+}
+
+void AWeapon::SetItemProperties(EItemState State)
+{
+	if (State != EItemState::EIS_PickUp && !bWeaponAssetsApplied)
+	{
+		ApplyWeaponAssets();
 	}
+
+	Super::SetItemProperties(State);
 }
 
 void AWeapon::BeginPlay()
@@ -192,4 +288,23 @@ void AWeapon::BeginPlay()
 	{
 		GetItemSkeletalMesh()->HideBoneByName(BoneToHide, PBO_None);
 	}
+
+	if (UWeaponStreamingSubsystem* WeaponStreaming = GetWorld()->GetSubsystem<UWeaponStreamingSubsystem>())
+	{
+		WeaponStreaming->RegisterWeapon(this);
+	}
+	else if (!bWeaponAssetsApplied)
+	{
+		ApplyWeaponAssets();
+	}
+}
+
+void AWeapon::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UWeaponStreamingSubsystem* WeaponStreaming = GetWorld()->GetSubsystem<UWeaponStreamingSubsystem>())
+	{
+		WeaponStreaming->UnregisterWeapon(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
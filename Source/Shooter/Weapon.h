@@ -26,25 +26,25 @@ struct FWeaponDataTable : public FTableRowBase
 	int32 MagazineCapacity;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	class USoundCue* PickUpSound;
+	TSoftObjectPtr<class USoundCue> PickUpSound;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	USoundCue* EquipSound;
+	TSoftObjectPtr<USoundCue> EquipSound;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	USkeletalMesh* ItemMesh;
+	TSoftObjectPtr<USkeletalMesh> ItemMesh;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	FString ItemName;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UTexture2D* InventoryIcon;
+	TSoftObjectPtr<UTexture2D> InventoryIcon;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UTexture2D* AmmoIcon;
+	TSoftObjectPtr<UTexture2D> AmmoIcon;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UMaterialInstance* MaterialInstance;
+	TSoftObjectPtr<UMaterialInstance> MaterialInstance;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	int32 MaterialIndex;
@@ -56,31 +56,31 @@ struct FWeaponDataTable : public FTableRowBase
 	FName ReloadMontageSection;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	TSubclassOf<UAnimInstance> AnimBP;
+	TSoftClassPtr<UAnimInstance> AnimBP;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UTexture2D* CrossHairsMiddle;
+	TSoftObjectPtr<UTexture2D> CrossHairsMiddle;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UTexture2D* CrossHairsLeft;
+	TSoftObjectPtr<UTexture2D> CrossHairsLeft;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UTexture2D* CrossHairsRight;
+	TSoftObjectPtr<UTexture2D> CrossHairsRight;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UTexture2D* CrossHairsBottom;
+	TSoftObjectPtr<UTexture2D> CrossHairsBottom;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UTexture2D* CrossHairsTop;
+	TSoftObjectPtr<UTexture2D> CrossHairsTop;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	float AutoFireRate;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UParticleSystem* MuzzleFlash;
+	TSoftObjectPtr<UParticleSystem> MuzzleFlash;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	USoundCue* FireSound;
+	TSoftObjectPtr<USoundCue> FireSound;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	FName BoneToHide;
@@ -93,6 +93,35 @@ struct FWeaponDataTable : public FTableRowBase
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	float HeadShotDamage;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 FXPoolSize;
+
+	/** Rays traced per shot, more than one for the shotgun */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 PelletCount = 1;
+
+	/** Half angle in degrees of the cone the pellets spread in */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float PelletSpreadAngle = 0.f;
+
+	/** Launch speed of the projectiles, 0 for a hitscan weapon */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float ProjectileSpeed = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float ProjectileGravityScale = 1.f;
+
+	/** Velocity lost per second, proportional to the velocity */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float ProjectileDrag = 0.f;
+
+	/** Seconds a projectile flies before it is dropped */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float ProjectileLifetime = 5.f;
+
+	/** Paths of every asset referenced by the row, used to stream them in */
+	void GetAssetPaths(TArray<FSoftObjectPath>& OutPaths) const;
 };
 
 #pragma endregion
@@ -116,9 +145,18 @@ protected:
 	//Called to change Weapon State 
 	void StropFalling();
 
+	/** Also ticks while falling upright or moving the pistol slide */
+	virtual bool HasTickWork() const override;
+
+	/** Any state but PickUp needs the weapon assets, loaded synchronously if they were not streamed in */
+	virtual void SetItemProperties(EItemState State) override;
+
+	/** Copies the weapon row, in a game world the assets wait for the weapon streaming subsystem */
 	virtual void OnConstruction(const FTransform& Transform) override;
 
 	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 private:
 	// Timer for throwing weapon 
 	FTimerHandle ThrowWeaponTimer;
@@ -206,8 +244,9 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Pistol", meta=(AllowPrivateAccess="true"))
 	UCurveFloat* SlideDisplacementCurve;
 
-	/** Timer Handle for updating Slide displacement */
-	FTimerHandle SlideTimer;
+	/** Slide cooldown, its elapsed time drives the slide displacement */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Pistol", meta=(AllowPrivateAccess="true"))
+	class UCooldownComponent* Cooldowns;
 
 	/** Time for displacing the slide during pistol fire  */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Pistol", meta=(AllowPrivateAccess="true"))
@@ -241,7 +280,47 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Weapon Properties", meta=(AllowPrivateAccess="true"))
 	float HeadShotDamage;
 
+	/** Muzzle flash, beam and impact components kept ready in the FX pool while this weapon is equipped */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Weapon Properties", meta=(AllowPrivateAccess="true"))
+	int32 FXPoolSize;
+
+	/** Rays traced per shot, hits on the same actor add up to one damage event */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Weapon Properties", meta=(AllowPrivateAccess="true"))
+	int32 PelletCount;
+
+	/** Half angle in degrees of the cone the pellets spread in around the crossHair direction */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Weapon Properties", meta=(AllowPrivateAccess="true"))
+	float PelletSpreadAngle;
+
+	/** Launch speed of the projectiles simulated by the projectile subsystem, 0 for a hitscan weapon */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Weapon Properties", meta=(AllowPrivateAccess="true"))
+	float ProjectileSpeed;
+
+	/** Scale of the world gravity on the projectiles */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Weapon Properties", meta=(AllowPrivateAccess="true"))
+	float ProjectileGravityScale;
+
+	/** Velocity the projectiles lose per second, proportional to their velocity */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Weapon Properties", meta=(AllowPrivateAccess="true"))
+	float ProjectileDrag;
+
+	/** Seconds a projectile flies before it is dropped */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Weapon Properties", meta=(AllowPrivateAccess="true"))
+	float ProjectileLifetime;
+
+	/** True once the mesh, material, sounds and textures of the weapon row are set on the weapon */
+	UPROPERTY()
+	bool bWeaponAssetsApplied;
+
 public:
+	/** Set the assets of the weapon row, any asset not streamed in yet is loaded synchronously */
+	void ApplyWeaponAssets();
+
+	/** Drop the references to the weapon row assets so a far pickup does not keep them loaded */
+	void ReleaseWeaponAssets();
+
+	FORCEINLINE bool HasWeaponAssets() const { return bWeaponAssetsApplied; }
+
 	// Called to throw Equipped weapon 
 	void ThrowWeapon();
 
@@ -284,6 +363,20 @@ public:
 
 	FORCEINLINE float GetHeadShotDamage() const { return HeadShotDamage; }
 
+	FORCEINLINE int32 GetFXPoolSize() const { return FXPoolSize; }
+
+	FORCEINLINE int32 GetPelletCount() const { return PelletCount; }
+
+	FORCEINLINE float GetPelletSpreadAngle() const { return PelletSpreadAngle; }
+
+	FORCEINLINE float GetProjectileSpeed() const { return ProjectileSpeed; }
+
+	FORCEINLINE float GetProjectileGravityScale() const { return ProjectileGravityScale; }
+
+	FORCEINLINE float GetProjectileDrag() const { return ProjectileDrag; }
+
+	FORCEINLINE float GetProjectileLifetime() const { return ProjectileLifetime; }
+
 protected:
 	void FinishMovingSlide();
 
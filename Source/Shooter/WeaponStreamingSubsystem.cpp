@@ -0,0 +1,260 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WeaponStreamingSubsystem.h"
+
+#include "ItemRegistrySubsystem.h"
+#include "Shooter.h"
+#include "ShooterCharacter.h"
+#include "ShooterDataSubsystem.h"
+#include "Weapon.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_MEMORY_STAT(TEXT("Streamed Weapon Assets"), STAT_StreamedWeaponAssetMemory, STATGROUP_ShooterStreaming);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Streamed Weapon Types"), STAT_StreamedWeaponTypes, STATGROUP_ShooterStreaming);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Weapon Async Load (ms)"), STAT_WeaponAsyncLoadTime, STATGROUP_ShooterStreaming);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Weapon Sync Loads"), STAT_WeaponSyncLoads, STATGROUP_ShooterStreaming);
+DECLARE_CYCLE_STAT(TEXT("Weapon Sync Load"), STAT_WeaponSyncLoad, STATGROUP_ShooterStreaming);
+DECLARE_CYCLE_STAT(TEXT("Weapon Streaming Update"), STAT_WeaponStreamingUpdate, STATGROUP_ShooterStreaming);
+
+UWeaponStreamingSubsystem::UWeaponStreamingSubsystem():
+	StreamingRadius(8000.f),
+	ReleaseRadius(12000.f),
+	PickupCullDistance(6000.f),
+	UpdateInterval(0.5f),
+	TimeSinceUpdate(0.f)
+{
+}
+
+void UWeaponStreamingSubsystem::Deinitialize()
+{
+	for (auto& HandlePair : WeaponAssetHandles)
+	{
+		if (HandlePair.Value.IsValid())
+		{
+			HandlePair.Value->ReleaseHandle();
+		}
+	}
+	DEC_DWORD_STAT_BY(STAT_StreamedWeaponTypes, WeaponAssetHandles.Num());
+	WeaponAssetHandles.Empty();
+	Weapons.Empty();
+	UpdateMemoryStat();
+
+	Super::Deinitialize();
+}
+
+void UWeaponStreamingSubsystem::RegisterWeapon(AWeapon* Weapon)
+{
+	if (Weapon == nullptr) return;
+
+	Weapons.AddUnique(Weapon);
+	Weapon->GetItemSkeletalMesh()->SetCullDistance(PickupCullDistance);
+	if (Weapon->HasWeaponAssets()) return;
+
+	const EWeaponType WeaponType{Weapon->GetWeaponType()};
+	if (IsWeaponTypeLoaded(WeaponType))
+	{
+		Weapon->ApplyWeaponAssets();
+		return;
+	}
+
+	// No player yet to measure from, treat the weapon as in view
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+	const float DistanceSquared{
+		PlayerPawn ? FVector::DistSquared(PlayerPawn->GetActorLocation(), Weapon->GetActorLocation()) : 0.f
+	};
+
+	// Spawned near the player, stream the type now rather than at the next update
+	if (DistanceSquared <= FMath::Square(StreamingRadius) && !WeaponAssetHandles.Contains(WeaponType))
+	{
+		RequestWeaponAssets(WeaponType);
+	}
+
+	// Close enough to be drawn, a sync load beats an invisible pickup
+	if (DistanceSquared <= FMath::Square(PickupCullDistance))
+	{
+		Weapon->ApplyWeaponAssets();
+	}
+}
+
+void UWeaponStreamingSubsystem::UnregisterWeapon(AWeapon* Weapon)
+{
+	Weapons.RemoveSwap(Weapon);
+}
+
+bool UWeaponStreamingSubsystem::IsWeaponTypeLoaded(EWeaponType WeaponType) const
+{
+	const TSharedPtr<FStreamableHandle>* Handle = WeaponAssetHandles.Find(WeaponType);
+	return Handle && Handle->IsValid() && (*Handle)->HasLoadCompleted();
+}
+
+UObject* UWeaponStreamingSubsystem::LoadAssetSynchronous(const FSoftObjectPath& AssetPath)
+{
+	// Every call is a hitch the streaming should have avoided
+	SCOPE_CYCLE_COUNTER(STAT_WeaponSyncLoad);
+	INC_DWORD_STAT(STAT_WeaponSyncLoads);
+	return AssetPath.TryLoad();
+}
+
+void UWeaponStreamingSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceUpdate += DeltaTime;
+	if (TimeSinceUpdate < UpdateInterval) return;
+	TimeSinceUpdate = 0.f;
+
+	SCOPE_CYCLE_COUNTER(STAT_WeaponStreamingUpdate);
+
+	TSet<EWeaponType> WantedWeaponTypes;
+	TSet<EWeaponType> KeptWeaponTypes;
+	// Without a player, e.g. while respawning, keep everything as it is
+	if (!GatherWantedWeaponTypes(WantedWeaponTypes, KeptWeaponTypes)) return;
+
+	for (const EWeaponType WeaponType : WantedWeaponTypes)
+	{
+		if (!WeaponAssetHandles.Contains(WeaponType))
+		{
+			RequestWeaponAssets(WeaponType);
+		}
+	}
+
+	// Release the types nothing within ReleaseRadius needs, their pickups are all past the cull distance.
+	// Held and thrown weapons keep their own references
+	ReleaseUnwantedPickups(KeptWeaponTypes);
+
+	bool bReleased = false;
+	for (auto It = WeaponAssetHandles.CreateIterator(); It; ++It)
+	{
+		if (!KeptWeaponTypes.Contains(It.Key()))
+		{
+			if (It.Value().IsValid())
+			{
+				It.Value()->ReleaseHandle();
+			}
+			It.RemoveCurrent();
+			DEC_DWORD_STAT(STAT_StreamedWeaponTypes);
+			bReleased = true;
+		}
+	}
+	if (bReleased)
+	{
+		UpdateMemoryStat();
+	}
+}
+
+bool UWeaponStreamingSubsystem::GatherWantedWeaponTypes(TSet<EWeaponType>& OutWantedTypes,
+                                                        TSet<EWeaponType>& OutKeptTypes) const
+{
+	const AShooterCharacter* ShooterCharacter = Cast<AShooterCharacter>(
+		UGameplayStatics::GetPlayerPawn(GetWorld(), 0));
+	if (ShooterCharacter == nullptr) return false;
+
+	for (const AItem* Item : ShooterCharacter->GetInventory())
+	{
+		if (const AWeapon* Weapon = Cast<AWeapon>(Item))
+		{
+			OutWantedTypes.Add(Weapon->GetWeaponType());
+			OutKeptTypes.Add(Weapon->GetWeaponType());
+		}
+	}
+
+	const UItemRegistrySubsystem* ItemRegistry = GetWorld()->GetSubsystem<UItemRegistrySubsystem>();
+	if (ItemRegistry)
+	{
+		const FVector PlayerLocation{ShooterCharacter->GetActorLocation()};
+		TArray<AItem*> NearbyItems;
+		ItemRegistry->QueryItems(PlayerLocation, ReleaseRadius, NearbyItems);
+		for (const AItem* Item : NearbyItems)
+		{
+			if (const AWeapon* Weapon = Cast<AWeapon>(Item))
+			{
+				OutKeptTypes.Add(Weapon->GetWeaponType());
+				if (FVector::DistSquared(Weapon->GetActorLocation(), PlayerLocation) <= FMath::Square(StreamingRadius))
+				{
+					OutWantedTypes.Add(Weapon->GetWeaponType());
+				}
+			}
+		}
+	}
+	return true;
+}
+
+void UWeaponStreamingSubsystem::ReleaseUnwantedPickups(const TSet<EWeaponType>& WantedWeaponTypes)
+{
+	for (const TWeakObjectPtr<AWeapon>& WeakWeapon : Weapons)
+	{
+		AWeapon* Weapon = WeakWeapon.Get();
+		if (Weapon && Weapon->HasWeaponAssets() && Weapon->GetItemState() == EItemState::EIS_PickUp &&
+			!WantedWeaponTypes.Contains(Weapon->GetWeaponType()))
+		{
+			Weapon->ReleaseWeaponAssets();
+		}
+	}
+}
+
+void UWeaponStreamingSubsystem::RequestWeaponAssets(EWeaponType WeaponType)
+{
+	const FWeaponDataTable* WeaponDefinition = UShooterDataSubsystem::GetWeaponDefinition(this, WeaponType);
+	if (WeaponDefinition == nullptr) return;
+
+	TArray<FSoftObjectPath> AssetPaths;
+	WeaponDefinition->GetAssetPaths(AssetPaths);
+	if (AssetPaths.Num() == 0) return;
+
+	const FStreamableDelegate LoadedDelegate = FStreamableDelegate::CreateUObject(
+		this, &UWeaponStreamingSubsystem::OnWeaponAssetsLoaded, WeaponType, FPlatformTime::Seconds());
+	WeaponAssetHandles.Add(WeaponType, StreamableManager.RequestAsyncLoad(AssetPaths, LoadedDelegate));
+	INC_DWORD_STAT(STAT_StreamedWeaponTypes);
+}
+
+void UWeaponStreamingSubsystem::OnWeaponAssetsLoaded(EWeaponType WeaponType, double RequestTime)
+{
+	SET_FLOAT_STAT(STAT_WeaponAsyncLoadTime, (FPlatformTime::Seconds() - RequestTime) * 1000.0);
+	UpdateMemoryStat();
+
+	// Hand the assets to the weapons of the type waiting for them
+	for (const TWeakObjectPtr<AWeapon>& WeakWeapon : Weapons)
+	{
+		AWeapon* Weapon = WeakWeapon.Get();
+		if (Weapon && !Weapon->HasWeaponAssets() && Weapon->GetWeaponType() == WeaponType)
+		{
+			Weapon->ApplyWeaponAssets();
+		}
+	}
+}
+
+void UWeaponStreamingSubsystem::UpdateMemoryStat() const
+{
+#if STATS
+	int64 TotalBytes{0};
+	TSet<UObject*> CountedAssets;
+	for (const auto& HandlePair : WeaponAssetHandles)
+	{
+		if (!HandlePair.Value.IsValid()) continue;
+
+		TArray<UObject*> LoadedAssets;
+		HandlePair.Value->GetLoadedAssets(LoadedAssets);
+		for (UObject* Asset : LoadedAssets)
+		{
+			bool bAlreadyCounted = false;
+			CountedAssets.Add(Asset, &bAlreadyCounted);
+			if (Asset && !bAlreadyCounted)
+			{
+				TotalBytes += Asset->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+			}
+		}
+	}
+	SET_MEMORY_STAT(STAT_StreamedWeaponAssetMemory, TotalBytes);
+#endif
+}
+
+ETickableTickType UWeaponStreamingSubsystem::GetTickableTickType() const
+{
+	// The class default object never ticks
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Always;
+}
+
+TStatId UWeaponStreamingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWeaponStreamingSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,112 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "WeaponType.h"
+#include "Engine/StreamableManager.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WeaponStreamingSubsystem.generated.h"
+
+/**
+ * Streams in the assets of the weapon types the player holds or stands near,
+ * and releases them once no weapon of that type is around anymore.
+ * Weapons spawned in game wait here for their assets, and pickups of the
+ * released types drop theirs so the release actually frees memory.
+ * Pickups are culled past PickupCullDistance, types stream in from the larger
+ * StreamingRadius and are released past ReleaseRadius, so a pickup is never drawn without its assets
+ */
+UCLASS()
+class SHOOTER_API UWeaponStreamingSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UWeaponStreamingSubsystem();
+
+	virtual void Deinitialize() override;
+
+	/**
+	 * Track the weapon, it gets its assets now if its type is streamed in or it is close enough to be drawn,
+	 * else once the type finishes loading
+	 */
+	void RegisterWeapon(class AWeapon* Weapon);
+
+	void UnregisterWeapon(AWeapon* Weapon);
+
+	/** True once every asset of the weapon type finished streaming in */
+	bool IsWeaponTypeLoaded(EWeaponType WeaponType) const;
+
+	/** Loaded asset, loaded synchronously (a hitch) when it was not streamed in yet */
+	template <typename T>
+	static T* ResolveAsset(const TSoftObjectPtr<T>& Asset)
+	{
+		T* LoadedAsset = Asset.Get();
+		if (LoadedAsset == nullptr && !Asset.IsNull())
+		{
+			LoadedAsset = Cast<T>(LoadAssetSynchronous(Asset.ToSoftObjectPath()));
+		}
+		return LoadedAsset;
+	}
+
+	template <typename T>
+	static UClass* ResolveClass(const TSoftClassPtr<T>& Class)
+	{
+		UClass* LoadedClass = Class.Get();
+		if (LoadedClass == nullptr && !Class.IsNull())
+		{
+			LoadedClass = Cast<UClass>(LoadAssetSynchronous(Class.ToSoftObjectPath()));
+		}
+		return LoadedClass;
+	}
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+private:
+	static UObject* LoadAssetSynchronous(const FSoftObjectPath& AssetPath);
+
+	/**
+	 * Weapon types in the player inventory and in the pickups around the player
+	 * @param OutWantedTypes Types to stream in, held or within StreamingRadius
+	 * @param OutKeptTypes Types to keep loaded, held or within ReleaseRadius
+	 * @return False without a player to measure from
+	 */
+	bool GatherWantedWeaponTypes(TSet<EWeaponType>& OutWantedTypes, TSet<EWeaponType>& OutKeptTypes) const;
+
+	void RequestWeaponAssets(EWeaponType WeaponType);
+
+	void OnWeaponAssetsLoaded(EWeaponType WeaponType, double RequestTime);
+
+	/** Drop the assets of the pickups whose type nothing wants anymore */
+	void ReleaseUnwantedPickups(const TSet<EWeaponType>& WantedWeaponTypes);
+
+	/** Update the memory stat from the assets held by the handles */
+	void UpdateMemoryStat() const;
+
+	FStreamableManager StreamableManager;
+
+	/** Handles keeping the assets of each wanted weapon type loaded */
+	TMap<EWeaponType, TSharedPtr<FStreamableHandle>> WeaponAssetHandles;
+
+	/** Weapons in play, given or stripped of their assets as their type streams in and out */
+	TArray<TWeakObjectPtr<AWeapon>> Weapons;
+
+	/** Pickups closer than this to the player have their assets streamed in, more than PickupCullDistance */
+	float StreamingRadius;
+
+	/** A type is released once no weapon of it is closer than this, more than StreamingRadius to avoid thrashing */
+	float ReleaseRadius;
+
+	/** Draw distance of the weapon meshes, pickups without their assets are always farther than this */
+	float PickupCullDistance;
+
+	/** Seconds between two updates of the wanted weapon types */
+	float UpdateInterval;
+
+	float TimeSinceUpdate;
+};